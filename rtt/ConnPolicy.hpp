@@ -86,6 +86,9 @@ namespace RTT {
      *       the name contains a port number or file descriptor to be opened.
      *       You only need to provide a name_id if you're using out-of-band transports
      *       without supervisor, for example, when using MQueues without Corba.
+     *  <li> if the connection shares its storage with the other shared connections
+     *       of the same output port. A sample is then copied only once, regardless
+     *       of the number of readers. Only local connections can be shared.
      * </ul>
      * @ingroup Ports
      */
@@ -180,6 +183,16 @@ namespace RTT {
          * work around name clashes or if the transport protocol documents to do so.
          */
         mutable std::string name_id;
+
+        /**
+         * If true, all local connections of an output port with this flag and
+         * the same type and size share one lock-free storage. Each reader keeps
+         * its own read position, so NewData/OldData is reported per reader,
+         * while a write copies the sample only once. The lock_policy is ignored
+         * for shared connections. This flag is ignored for remote and
+         * out-of-band connections.
+         */
+        bool   shared;
     };
 }
 
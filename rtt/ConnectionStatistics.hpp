@@ -0,0 +1,112 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  ConnectionStatistics.hpp
+
+                        ConnectionStatistics.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_CONNECTION_STATISTICS_HPP
+#define ORO_CONNECTION_STATISTICS_HPP
+
+#include "ConnPolicy.hpp"
+#include <string>
+
+namespace RTT
+{
+    /**
+     * A snapshot of the data flow statistics of one connection of a port,
+     * since it was created or since the statistics were last reset. The
+     * counters are kept by the data storage element of the connection, so
+     * a connection of which the storage is in another process only has
+     * statistics on the side of its InputPort.
+     * @see base::PortInterface::getConnectionStatistics()
+     * @ingroup Ports
+     */
+    struct ConnectionStatistics
+    {
+        ConnectionStatistics()
+            : writes(0), drops(0), overwrites(0), high_water_mark(0),
+              reads(0), new_data(0), old_data(0), no_data(0),
+              last_write(0.0), last_read(0.0) {}
+
+        /**
+         * The name of the port of which this is a connection.
+         */
+        std::string port;
+        /**
+         * The policy with which the connection was created.
+         */
+        ConnPolicy policy;
+        /**
+         * The number of samples written in the connection, including
+         * the dropped ones.
+         */
+        unsigned int writes;
+        /**
+         * The number of samples that were not stored, because the
+         * buffer was full or the storage was in use by too many readers.
+         */
+        unsigned int drops;
+        /**
+         * The number of unread samples that were lost to make room for
+         * a new one, in a DATA connection or a full CIRCULAR_BUFFER.
+         */
+        unsigned int overwrites;
+        /**
+         * The largest number of samples stored at once.
+         */
+        unsigned int high_water_mark;
+        /**
+         * The number of reads of the connection, which equals
+         * new_data + old_data + no_data.
+         */
+        unsigned int reads;
+        unsigned int new_data;
+        unsigned int old_data;
+        unsigned int no_data;
+        /**
+         * The time of the last write, in seconds of the
+         * os::TimeService clock, or zero if none.
+         */
+        double last_write;
+        /**
+         * The time of the last read, in seconds of the
+         * os::TimeService clock, or zero if none.
+         */
+        double last_read;
+    };
+}
+
+#endif
@@ -151,8 +151,8 @@ namespace RTT
             return port;
         }
 #endif
-        if (callback)
-            mservice->getOwner()->dataOnPortCallback(&port,callback); // the handle will be deleted when the port is removed.
+        // registers the port as event port, the callback is optional:
+        mservice->getOwner()->dataOnPortCallback(&port,callback); // the handle will be deleted when the port is removed.
 
 #ifndef ORO_SIGNALLING_PORTS
         port.signalInterface(true);
@@ -186,6 +186,8 @@ namespace RTT
               it != mports.end();
               ++it)
             if ( (*it)->getName() == name ) {
+                if (mservice && mservice->getOwner())
+                    mservice->getOwner()->dataOnPortRemoved( *it );
                 (*it)->disconnect(); // remove all connections and callbacks.
                 (*it)->setInterface(0);
                 mports.erase(it);
@@ -254,8 +256,11 @@ namespace RTT
         for ( Ports::iterator it(mports.begin());
               it != mports.end();
               ++it) {
-            if (mservice)
+            if (mservice) {
+                if (mservice->getOwner())
+                    mservice->getOwner()->dataOnPortRemoved( *it );
                 mservice->removeService( (*it)->getName() );
+            }
         }
         mports.clear();
     }
@@ -42,6 +42,7 @@
 #include "base/TaskCore.hpp"
 #include "rtt-fwd.hpp"
 #include "os/MutexLock.hpp"
+#include "os/CAS.hpp"
 #include "internal/MWSRQueue.hpp"
 #include "TaskContext.hpp"
 #include "internal/CatchConfig.hpp"
@@ -54,7 +55,9 @@
 #include <functional>
 #include <algorithm>
 
+#ifndef ORONUM_EE_MQUEUE_SIZE
 #define ORONUM_EE_MQUEUE_SIZE 100
+#endif
 
 namespace RTT
 {
@@ -72,9 +75,14 @@ namespace RTT
     ExecutionEngine::ExecutionEngine( TaskCore* owner )
         : taskc(owner),
           mqueue(new MWSRQueue<DisposableInterface*>(ORONUM_EE_MQUEUE_SIZE) ),
+          mqueue_overflow(0),
+          msg_pending(0),
+          max_queue_depth(0),
           f_queue( new MWSRQueue<ExecutableInterface*>(ORONUM_EE_MQUEUE_SIZE) ),
           mmaster(0)
     {
+        oro_atomic_set(&dropped_messages, 0);
+        oro_atomic_set(&coalesced_triggers, 0);
     }
 
     ExecutionEngine::~ExecutionEngine()
@@ -95,9 +103,57 @@ namespace RTT
         DisposableInterface* dis;
         while ( mqueue->dequeue( dis ) )
             dis->dispose();
+        while ( mqueue_overflow && mqueue_overflow->dequeue( dis ) )
+            dis->dispose();
 
         delete f_queue;
         delete mqueue;
+        delete mqueue_overflow;
+    }
+
+    bool ExecutionEngine::setMessageQueueCapacity(unsigned int capacity, unsigned int overflow)
+    {
+        if ( capacity == 0 || (this->getActivity() && this->getActivity()->isActive()) || hasWork() )
+            return false;
+        delete mqueue;
+        mqueue = new MWSRQueue<DisposableInterface*>(capacity);
+        delete mqueue_overflow;
+        mqueue_overflow = overflow ? new MWSRQueue<DisposableInterface*>(overflow) : 0;
+        return true;
+    }
+
+    unsigned int ExecutionEngine::getMessageQueueCapacity() const
+    {
+        return mqueue->capacity();
+    }
+
+    unsigned int ExecutionEngine::getMessageOverflowCapacity() const
+    {
+        return mqueue_overflow ? mqueue_overflow->capacity() : 0;
+    }
+
+    bool ExecutionEngine::setFunctionQueueCapacity(unsigned int capacity)
+    {
+        if ( capacity == 0 || (this->getActivity() && this->getActivity()->isActive()) || !f_queue->isEmpty() )
+            return false;
+        delete f_queue;
+        f_queue = new MWSRQueue<ExecutableInterface*>(capacity);
+        return true;
+    }
+
+    unsigned int ExecutionEngine::getDroppedMessages() const
+    {
+        return oro_atomic_read(&dropped_messages);
+    }
+
+    unsigned int ExecutionEngine::getCoalescedTriggers() const
+    {
+        return oro_atomic_read(&coalesced_triggers);
+    }
+
+    unsigned int ExecutionEngine::getMaxQueueDepth() const
+    {
+        return max_queue_depth;
     }
 
     TaskCore* ExecutionEngine::getParent() {
@@ -209,13 +265,15 @@ namespace RTT
     }
 
     bool ExecutionEngine::initialize() {
-        // nop
+        // a trigger which was lost while we were stopped may not
+        // prevent the next message from triggering us.
+        msg_pending = 0;
         return true;
     }
 
     bool ExecutionEngine::hasWork()
     {
-        return !mqueue->isEmpty();
+        return !mqueue->isEmpty() || (mqueue_overflow && !mqueue_overflow->isEmpty());
     }
 
     void ExecutionEngine::processMessages()
@@ -224,10 +282,17 @@ namespace RTT
         // msg_lock may not be held when entering this function !
         DisposableInterface* com(0);
         {
-            while ( mqueue->dequeue(com) ) {
+            // from here on, a new message must trigger us again.
+            // The CAS orders this before the dequeues below.
+            os::CAS(&msg_pending, 1, 0);
+            unsigned int depth = 0;
+            while ( mqueue->dequeue(com) || (mqueue_overflow && mqueue_overflow->dequeue(com)) ) {
                 assert( com );
                 com->executeAndDispose();
+                ++depth;
             }
+            if ( depth > max_queue_depth )
+                max_queue_depth = depth;
             // there's no need to hold the lock during
             // emptying the queue. But we must hold the
             // lock once between excuteAndDispose and the
@@ -255,9 +320,26 @@ namespace RTT
             }
 
             bool result = mqueue->enqueue( c );
-            this->getActivity()->trigger();
+            if ( !result && mqueue_overflow )
+                result = mqueue_overflow->enqueue( c );
+            if ( !result ) {
+                oro_atomic_inc(&dropped_messages);
+                return false;
+            }
+
+            // Only the first message since processMessages() wakes us up,
+            // the others are processed in the same batch.
+            if ( !os::CAS(&msg_pending, 0, 1) ) {
+                oro_atomic_inc(&coalesced_triggers);
+                return true;
+            }
+            if ( !this->getActivity()->trigger() )
+                msg_pending = 0; // not active or periodic: let the next message try again.
+            // take the lock such that the EE thread is either waiting
+            // or will see the message in waitAndProcessMessages().
+            { MutexLock locker( msg_lock ); }
             msg_cond.broadcast(); // required for waitAndProcessMessages() (EE thread)
-            return result;
+            return true;
         }
         return false;
     }
@@ -318,7 +400,10 @@ namespace RTT
                 // We must lock because the cond variable will unlock msg_lock.
                 os::MutexLock lock(msg_lock);
                 if (!pred()) {
-                    msg_cond.wait(msg_lock); // now processMessages may run.
+                    // a message which arrived after processMessages() only
+                    // broadcasts when it was the first one.
+                    if ( !hasWork() )
+                        msg_cond.wait(msg_lock); // now processMessages may run.
                 } else {
                     return; // do not process messages when pred() == true;
                 }
@@ -42,6 +42,7 @@
 #include "os/Mutex.hpp"
 #include "os/MutexLock.hpp"
 #include "os/Condition.hpp"
+#include "os/oro_arch.h"
 #include "base/RunnableInterface.hpp"
 #include "base/ActivityInterface.hpp"
 #include "base/DisposableInterface.hpp"
@@ -111,9 +112,12 @@ namespace RTT
         /**
          * Queue and execute (process) a given message. The message is
          * executed in step() or loop() directly after all other
-         * queued ActionInterface objects. The constructor parameter
-         * \a queue_size limits how many messages can be queued in
-         * between step()s or loop().
+         * queued ActionInterface objects. The message queue capacity,
+         * see setMessageQueueCapacity(), limits how many messages can be
+         * queued in between step()s or loop().
+         *
+         * Only the first message after a step() triggers the activity,
+         * the following ones are executed in the same batch.
          *
          * @return true if the message got accepted, false otherwise.
          * @return false when the MessageProcessor is not running or does not accept messages.
@@ -121,6 +125,60 @@ namespace RTT
          */
         virtual bool process(base::DisposableInterface* c);
 
+        /**
+         * Change the number of messages which can be queued in between
+         * step()s. When the queue is full, messages go to a second,
+         * overflow queue of \a overflow elements and are executed after
+         * the others. Messages which do not fit in either queue are
+         * dropped and counted in getDroppedMessages().
+         *
+         * The queues are allocated here. Call this function before
+         * other threads send messages, for example in the constructor
+         * of the component.
+         * @param capacity The number of messages in the normal queue.
+         * @param overflow The number of messages in the overflow queue,
+         * zero for no overflow queue.
+         * @return false if the activity is active or messages are queued.
+         */
+        bool setMessageQueueCapacity(unsigned int capacity, unsigned int overflow = 0);
+
+        /**
+         * Returns the number of messages which can be queued in the
+         * normal message queue.
+         */
+        unsigned int getMessageQueueCapacity() const;
+
+        /**
+         * Returns the number of messages which can be queued in the
+         * overflow queue.
+         */
+        unsigned int getMessageOverflowCapacity() const;
+
+        /**
+         * Change the number of functions which can run in this engine.
+         * Same restrictions as setMessageQueueCapacity().
+         * @return false if the activity is active or functions are loaded.
+         */
+        bool setFunctionQueueCapacity(unsigned int capacity);
+
+        /**
+         * Returns the number of messages which were rejected because
+         * the message queues were full.
+         */
+        unsigned int getDroppedMessages() const;
+
+        /**
+         * Returns the number of messages which did not trigger the
+         * activity, because an earlier message already did.
+         */
+        unsigned int getCoalescedTriggers() const;
+
+        /**
+         * Returns the largest number of messages executed in one batch,
+         * which is the largest queue depth observed by this engine.
+         */
+        unsigned int getMaxQueueDepth() const;
+
         /**
          * Run a given function in step() or loop(). The function may only
          * be destroyed after the
@@ -253,6 +311,24 @@ namespace RTT
          */
         internal::MWSRQueue<base::DisposableInterface*>* mqueue;
 
+        /**
+         * Receives messages when mqueue is full, may be null.
+         */
+        internal::MWSRQueue<base::DisposableInterface*>* mqueue_overflow;
+
+        /**
+         * Set by the first message after processMessages() started,
+         * the following messages do not trigger the activity.
+         */
+        int volatile msg_pending;
+
+        /**
+         * Message queue statistics.
+         */
+        oro_atomic_t dropped_messages;
+        oro_atomic_t coalesced_triggers;
+        unsigned int max_queue_depth;
+
         std::vector<base::TaskCore*> children;
 
         /**
@@ -68,7 +68,8 @@ namespace RTT
 
         bool do_read(typename base::ChannelElement<T>::reference_t sample, FlowStatus& result, bool copy_old_data, const internal::ConnectionManager::ChannelDescriptor& descriptor)
         {
-            typename base::ChannelElement<T>::shared_ptr input = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
+            // the descriptor keeps the channel alive, no need to take a reference.
+            base::ChannelElement<T>* input = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
             assert( result != NewData );
             if ( input ) {
                 FlowStatus tresult = input->read(sample, copy_old_data);
@@ -84,6 +85,43 @@ namespace RTT
             return false;
         }
 
+        bool do_read_all(std::vector<T>& samples, FlowStatus& result, bool copy_old_data, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            base::ChannelElement<T>* input = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
+            assert( result != NewData );
+            if ( input ) {
+                FlowStatus tresult = input->readAll(samples);
+                if (tresult == NewData) {
+                    result = tresult;
+                    return true;
+                }
+                if (tresult > result)
+                    result = tresult;
+            }
+            return false;
+        }
+
+        bool do_read_loaned(typename base::ChannelElement<T>::value_t const*& sample, FlowStatus& result, bool copy_old_data, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            base::ChannelElement<T>* input = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
+            assert( result != NewData );
+            if ( input ) {
+                typename base::ChannelElement<T>::value_t const* tsample = 0;
+                FlowStatus tresult = input->readLoaned(tsample);
+                if (tresult == NewData) {
+                    sample = tsample;
+                    result = tresult;
+                    return true;
+                }
+                // the current channel has precedence for providing OldData.
+                if ( tresult == OldData && (copy_old_data || result == NoData) )
+                    sample = tsample;
+                if (tresult > result)
+                    result = tresult;
+            }
+            return false;
+        }
+
         /**
          * You are not allowed to copy ports.
          * In case you want to create a container of ports,
@@ -157,6 +195,43 @@ namespace RTT
         }
 
 
+        /** Reads a sample from the connection without copying it, if the
+         * connection supports it. \a sample is set to point to the sample
+         * in the connection if the method returns NewData or OldData. The
+         * sample may not be modified and remains valid until the next read(),
+         * readLoaned() or clear() on this port, or until the port is
+         * disconnected.
+         *
+         * Buffered and shared connections (ConnPolicy::shared) avoid the copy,
+         * data connections copy the sample once into the connection.
+         */
+        FlowStatus readLoaned(typename base::ChannelElement<T>::value_t const*& sample)
+        {
+            FlowStatus result = NoData;
+            cmanager.select_reader_channel( boost::bind( &InputPort::do_read_loaned, this, boost::ref(sample), boost::ref(result), boost::lambda::_1, boost::lambda::_2), true );
+            return result;
+        }
+
+        /** Reads all new samples of a connection at once. \a samples is
+         * cleared and filled with the new samples, oldest first. Like read(),
+         * only the samples of one connection are returned per call, the one
+         * which was read last has precedence.
+         *
+         * A buffered connection is drained in one call, a data connection
+         * returns at most one sample. Reserve \a samples up front to read
+         * without allocating memory.
+         *
+         * @return NewData if at least one sample was read, OldData or
+         * NoData otherwise, in which case \a samples is empty.
+         */
+        FlowStatus readAll(std::vector<T>& samples)
+        {
+            FlowStatus result = NoData;
+            samples.clear();
+            cmanager.select_reader_channel( boost::bind( &InputPort::do_read_all, this, boost::ref(samples), boost::ref(result), boost::lambda::_1, boost::lambda::_2), false );
+            return result;
+        }
+
         /** Read all new samples that are available on this port, and returns
          * the last one.
          *
@@ -183,7 +258,7 @@ namespace RTT
          */
         void getDataSample(T& sample)
         {
-            typename base::ChannelElement<T>::shared_ptr input = static_cast< base::ChannelElement<T>* >( cmanager.getCurrentChannel() );
+            typename base::ChannelElement<T>::shared_ptr input = static_cast< base::ChannelElement<T>* >( cmanager.getCurrentChannel().get() );
             if ( input ) {
                 sample = input->data_sample();
             }
@@ -41,9 +41,16 @@
 #include "os/MutexLock.hpp"
 #include "os/Mutex.hpp"
 #include "os/TimeService.hpp"
+#include "os/Thread.hpp"
+#include "os/CAS.hpp"
+#include "os/Atomic.hpp"
+#include "internal/PaddedTsPool.hpp"
+#include "internal/PaddedMWSRQueue.hpp"
 
 #include "Logger.hpp"
 #include <iomanip>
+#include <streambuf>
+#include <cstring>
 
 #ifdef OROSEM_PRINTF_LOGGING
 #  include <stdio.h>
@@ -114,6 +121,82 @@ namespace RTT
 
 #endif
 
+#ifndef ORONUM_LOGGING_RECORD_SIZE
+#define ORONUM_LOGGING_RECORD_SIZE 256
+#endif
+#ifndef ORONUM_LOGGING_MODULE_SIZE
+#define ORONUM_LOGGING_MODULE_SIZE 64
+#endif
+
+    namespace {
+        /**
+         * A message composed by a thread in asynchronous mode.
+         */
+        struct LogRecord
+        {
+            TimeService::ticks time;
+            Logger::LogLevel level;
+            bool flush;
+            std::size_t length;
+            char module[ORONUM_LOGGING_MODULE_SIZE];
+            char text[ORONUM_LOGGING_RECORD_SIZE];
+        };
+
+        /**
+         * Writes into the text of a LogRecord. Characters beyond
+         * its end are discarded.
+         */
+        struct RecordBuf
+            : public std::streambuf
+        {
+            void reset(char* b, std::size_t n) { setp(b, b + n); }
+            std::size_t length() const { return pptr() - pbase(); }
+        };
+
+        /**
+         * The log records of one thread. The thread itself allocates
+         * records from the pool and queues them, the drain thread writes
+         * them out and returns them to the pool.
+         */
+        struct ThreadLog
+        {
+            ThreadLog(unsigned int records)
+                : pool(records), queue(records), current(0), skip(false),
+                  level(Logger::Info), line(&buf), next(0)
+            {
+                std::memset(module, 0, sizeof(module));
+                std::strcpy(module, "Logger");
+            }
+
+            internal::PaddedTsPool<LogRecord> pool;
+            internal::PaddedMWSRQueue<LogRecord*> queue;
+            /**
+             * The record being composed, if any.
+             */
+            LogRecord* current;
+            /**
+             * True if the message being composed is discarded.
+             */
+            bool skip;
+            Logger::LogLevel level;
+            char module[ORONUM_LOGGING_MODULE_SIZE];
+            RecordBuf buf;
+            std::ostream line;
+            ThreadLog* next;
+        };
+
+#if defined(__GNUC__)
+#define ORO_LOGGER_ASYNC
+        /**
+         * The ThreadLog of the calling thread, valid if thread_log_gen
+         * equals the generation of the Logger.
+         */
+        __thread ThreadLog* thread_log = 0;
+        __thread unsigned int thread_log_gen = 0;
+        unsigned int log_generation = 0;
+#endif
+    }
+
     Logger& Logger::log() {
         return *Instance();
     }
@@ -147,8 +230,10 @@ namespace RTT
               timestamp(0),
               started(false), showtime(true), allowRT(false),
               mlogStdOut(true), mlogFile(true),
-              moduleptr("Logger")
+              moduleptr("Logger"),
+              drain(0), threadlogs(0), generation(0), records(0), policy(Logger::DropRecord)
         {
+            oro_atomic_set(&dropped, 0);
 #if defined(OROSEM_FILE_LOGGING) && !defined(OROSEM_LOG4CPP_LOGGING) && defined(OROSEM_PRINTF_LOGGING)
             logfile = fopen(logfile_name ? logfile_name : "orocos.log","w");
 #endif
@@ -160,14 +245,36 @@ namespace RTT
             return true;
         }
 
+        ~D()
+        {
+            while ( threadlogs ) {
+                ThreadLog* tl = threadlogs;
+                threadlogs = tl->next;
+                LogRecord* r;
+                while ( tl->queue.dequeue(r) )
+                    tl->pool.deallocate(r);
+                if ( tl->current )
+                    tl->pool.deallocate(tl->current);
+                delete tl;
+            }
+        }
+
         bool maylogStdOut() const {
-            if ( inloglevel <= outloglevel && outloglevel != Never && inloglevel != Never && mlogStdOut)
+            return maylogStdOut(inloglevel);
+        }
+
+        bool maylogStdOut(LogLevel ll) const {
+            if ( ll <= outloglevel && outloglevel != Never && ll != Never && mlogStdOut)
                 return true;
             return false;
         }
 
         bool maylogFile() const {
-            if ( (inloglevel <= Info || inloglevel <= outloglevel)  && mlogFile)
+            return maylogFile(inloglevel);
+        }
+
+        bool maylogFile(LogLevel ll) const {
+            if ( (ll <= Info || ll <= outloglevel)  && mlogFile)
                 return true;
             return false;
         }
@@ -183,24 +290,44 @@ namespace RTT
             os::MutexLock lock( inpguard );
             std:: string res = showTime() +" " + showLevel(inloglevel) + showModule() + " ";
 
+#if defined(OROSEM_FILE_LOGGING) || defined(OROSEM_REMOTE_LOGGING)
+            output( inloglevel, res, logline.str(), fileline.str(), pf );
+#else
+            output( inloglevel, res, logline.str(), std::string(), pf );
+#endif
+            // clear stringstreams.
+            if ( maylogStdOut() )
+                logline.str("");
+#if defined(OROSEM_FILE_LOGGING) || defined(OROSEM_REMOTE_LOGGING)
+            if ( maylogFile() )
+                fileline.str("");
+#endif
+        }
+
+        /**
+         * Writes one log message of level \a ll, prefixed with \a res,
+         * to screen, disk or stream. The caller holds inpguard.
+         */
+        void output(LogLevel ll, const std::string& res, const std::string& stdline,
+                    const std::string& fline, std::ostream& (*pf)(std::ostream&))
+        {
             // do not log if not wanted.
-            if ( maylogStdOut() ) {
+            if ( maylogStdOut(ll) ) {
 #ifndef OROSEM_PRINTF_LOGGING
-                *stdoutput << res << logline.str() << pf;
+                *stdoutput << res << stdline << pf;
 #else
-                printf("%s%s\n", res.c_str(), logline.str().c_str() );
+                printf("%s%s\n", res.c_str(), stdline.c_str() );
 #endif
-                logline.str("");   // clear stringstream.
             }
 
-            if ( maylogFile() ) {
+            if ( maylogFile(ll) ) {
 #ifdef OROSEM_FILE_LOGGING
 #if     defined(OROSEM_LOG4CPP_LOGGING)
-                category.log(level2Priority(inloglevel), fileline.str());
+                category.log(level2Priority(ll), fline);
 #elif   !defined(OROSEM_PRINTF_LOGGING)
-                logfile << res << fileline.str() << pf;
+                logfile << res << fline << pf;
 #else
-                fprintf( logfile, "%s%s\n", res.c_str(), fileline.str().c_str() );
+                fprintf( logfile, "%s%s\n", res.c_str(), fline.c_str() );
 #endif
 #ifdef OROSEM_REMOTE_LOGGING
                 // detect buffer 'overflow'
@@ -209,16 +336,122 @@ namespace RTT
                     remotestream >> dummy; // FIFO principle: read 1 line
                     --messagecnt;
                 }
-                remotestream << res << fileline.str() << pf;
+                remotestream << res << fline << pf;
                 ++messagecnt;
 #endif
-#if defined(OROSEM_FILE_LOGGING) || defined(OROSEM_REMOTE_LOGGING)
-                fileline.str("");
-#endif
 #endif
             }
         }
 
+#ifdef ORO_LOGGER_ASYNC
+        /**
+         * Returns the ThreadLog of the calling thread, and creates it
+         * when the thread logs for the first time.
+         */
+        ThreadLog* threadLog()
+        {
+            if ( thread_log_gen == generation )
+                return thread_log;
+            ThreadLog* tl = new ThreadLog(records);
+            {
+                os::MutexLock lock( inpguard );
+                std::strncpy( tl->module, moduleptr.c_str(), ORONUM_LOGGING_MODULE_SIZE - 1 );
+                tl->module[ORONUM_LOGGING_MODULE_SIZE - 1] = '\0';
+            }
+            ThreadLog* head;
+            do {
+                head = threadlogs;
+                tl->next = head;
+            } while ( !os::CAS( &threadlogs, head, tl ) );
+            thread_log = tl;
+            thread_log_gen = generation;
+            return tl;
+        }
+
+        /**
+         * Returns the stream of the message being composed by the calling
+         * thread, after taking a record for it if needed.
+         */
+        std::ostream* line(ThreadLog* tl)
+        {
+            if ( tl->skip )
+                return 0;
+            if ( tl->current == 0 ) {
+                if ( !maylogStdOut(tl->level) && !maylogFile(tl->level) ) {
+                    tl->skip = true;
+                    return 0;
+                }
+                tl->current = tl->pool.allocate();
+                while ( tl->current == 0 && policy == Logger::WaitForSpace ) {
+                    TIME_SPEC ts = ticks2timespec( nano2ticks( 1000000 ) );
+                    rtos_nanosleep( &ts, 0 );
+                    tl->current = tl->pool.allocate();
+                }
+                if ( tl->current == 0 ) {
+                    oro_atomic_inc( &dropped );
+                    tl->skip = true;
+                    return 0;
+                }
+                tl->buf.reset( tl->current->text, ORONUM_LOGGING_RECORD_SIZE );
+                tl->line.clear();
+            }
+            return &tl->line;
+        }
+
+        /**
+         * Ends the message of the calling thread and queues it for
+         * the drain thread.
+         */
+        void commit(bool flush)
+        {
+            ThreadLog* tl = threadLog();
+            line(tl);
+            LogRecord* r = tl->current;
+            tl->current = 0;
+            tl->skip = false;
+            if ( r == 0 )
+                return;
+            r->time = TimeService::Instance()->getTicks();
+            r->level = tl->level;
+            r->flush = flush;
+            r->length = tl->buf.length();
+            std::memcpy( r->module, tl->module, ORONUM_LOGGING_MODULE_SIZE );
+            // the queue holds as many records as the pool.
+            tl->queue.enqueue( r );
+        }
+
+        /**
+         * Writes out the queued records of all threads.
+         */
+        void drainRecords()
+        {
+            os::MutexLock lock( inpguard );
+            for ( ThreadLog* tl = threadlogs; tl; tl = tl->next ) {
+                LogRecord* r;
+                while ( tl->queue.dequeue(r) ) {
+                    std::string text( r->text, r->length );
+                    output( r->level, showTime(r->time) + " " + showLevel(r->level) + "[" + r->module + "] ",
+                            text, text, r->flush ? Logger::endl : Logger::nl );
+                    tl->pool.deallocate( r );
+                }
+            }
+        }
+
+        /**
+         * The thread writing out the records in asynchronous mode.
+         */
+        struct Drain
+            : public os::Thread
+        {
+            D* d;
+            Drain(D* owner, Seconds period)
+                : os::Thread(ORO_SCHED_OTHER, os::LowestPriority, period, ~0, "LogDrain"), d(owner)
+            {}
+            void step() { d->drainRecords(); }
+            void finalize() { d->drainRecords(); }
+        };
+#endif
+
 #ifndef OROSEM_PRINTF_LOGGING
         std::ostream* stdoutput;
 #endif
@@ -268,10 +501,15 @@ namespace RTT
 
 
         std::string showTime() const
+        {
+            return showTime( TimeService::Instance()->getTicks() );
+        }
+
+        std::string showTime(TimeService::ticks t) const
         {
             std::stringstream time;
             if ( showtime )
-                time <<fixed<< showpoint << setprecision(3) << TimeService::Instance()->secondsSince(timestamp);
+                time <<fixed<< showpoint << setprecision(3) << TimeService::ticks2nsecs(t - timestamp) / double(NSECS_IN_SECS);
             return time.str();
         }
 
@@ -328,17 +566,29 @@ namespace RTT
         std::string moduleptr;
 
         os::Mutex inpguard;
+
+#ifdef ORO_LOGGER_ASYNC
+        Drain* drain;
+#else
+        os::Thread* drain;
+#endif
+        ThreadLog* volatile threadlogs;
+        unsigned int generation;
+        unsigned int records;
+        Logger::OverflowPolicy policy;
+        oro_atomic_t dropped;
     };
 
     Logger::Logger(std::ostream& str)
         :d ( new Logger::D(str, getenv("ORO_LOGFILE")) ),
-         inpguard(d->inpguard), logline(d->logline), fileline(d->fileline)
+         inpguard(d->inpguard), logline(d->logline), fileline(d->fileline), async(false)
     {
       this->startup();
     }
 
     Logger::~Logger()
     {
+        this->setAsynchronous(false);
         delete d;
     }
 
@@ -420,6 +670,13 @@ namespace RTT
 
     Logger& Logger::in(const std::string& modname)
     {
+#ifdef ORO_LOGGER_ASYNC
+        if ( async ) {
+            ThreadLog* tl = d->threadLog();
+            std::strncpy( tl->module, modname.c_str(), ORONUM_LOGGING_MODULE_SIZE - 1 );
+            return *this;
+        }
+#endif
         os::MutexLock lock( d->inpguard );
         d->moduleptr = modname.c_str();
         return *this;
@@ -427,12 +684,23 @@ namespace RTT
 
     Logger& Logger::out(const std::string& oldmod)
     {
+#ifdef ORO_LOGGER_ASYNC
+        if ( async ) {
+            ThreadLog* tl = d->threadLog();
+            std::strncpy( tl->module, oldmod.c_str(), ORONUM_LOGGING_MODULE_SIZE - 1 );
+            return *this;
+        }
+#endif
         os::MutexLock lock( d->inpguard );
         d->moduleptr = oldmod.c_str();
         return *this;
     }
 
     std::string Logger::getLogModule() const {
+#ifdef ORO_LOGGER_ASYNC
+        if ( async )
+            return d->threadLog()->module;
+#endif
         os::MutexLock lock( d->inpguard );
         std::string ret = d->moduleptr.c_str();
         return ret;
@@ -495,6 +763,7 @@ namespace RTT
     void Logger::shutdown() {
         if (!d->started)
             return;
+        this->setAsynchronous(false);
         *this<<Logger::Info<<"Orocos Logging Deactivated." << Logger::endl;
         this->logflush();
         d->started = false;
@@ -525,10 +794,61 @@ namespace RTT
 #endif
     }
 
+    bool Logger::setAsynchronous(bool on, unsigned int records, OverflowPolicy policy, Seconds period) {
+#ifdef ORO_LOGGER_ASYNC
+        if ( async ) {
+            // pending records are written out by Drain::finalize().
+            async = false;
+            d->drain->stop();
+            delete d->drain;
+            d->drain = 0;
+        }
+        if ( !on )
+            return true;
+        if ( records == 0 || records > internal::PaddedTsPool<LogRecord>::max_capacity() )
+            return false;
+        if ( records != d->records || d->generation == 0 ) {
+            // threads create a new ThreadLog with the new size.
+            d->records = records;
+            d->generation = ++log_generation;
+        }
+        d->policy = policy;
+        d->drain = new D::Drain( d, period > 0 ? period : 0.01 );
+        async = true;
+        d->drain->start();
+        return true;
+#else
+        return !on;
+#endif
+    }
+
+    bool Logger::isAsynchronous() const {
+        return async;
+    }
+
+    unsigned int Logger::getDroppedRecords() const {
+        return oro_atomic_read( &d->dropped );
+    }
+
+    std::ostream* Logger::asyncLine() {
+#ifdef ORO_LOGGER_ASYNC
+        return d->line( d->threadLog() );
+#else
+        return 0;
+#endif
+    }
+
     Logger& Logger::operator<<( const char* t ) {
         if ( !d->maylog() )
             return *this;
 
+        if ( async ) {
+            std::ostream* line = this->asyncLine();
+            if ( line )
+                *line << t;
+            return *this;
+        }
+
         os::MutexLock lock( d->inpguard );
         if ( d->maylogStdOut() )
             d->logline << t;
@@ -548,6 +868,12 @@ namespace RTT
     Logger& Logger::operator<<(LogLevel ll) {
         if ( !d->maylog() )
             return *this;
+#ifdef ORO_LOGGER_ASYNC
+        if ( async ) {
+            d->threadLog()->level = ll;
+            return *this;
+        }
+#endif
         d->inloglevel = ll;
         return *this;
     }
@@ -562,6 +888,11 @@ namespace RTT
             this->lognl();
         else if ( pf == Logger::flush )
             this->logflush();
+        else if ( async ) {
+            std::ostream* line = this->asyncLine();
+            if ( line )
+                *line << pf;
+        }
         else {
             os::MutexLock lock( d->inpguard );
             if ( d->maylogStdOut() )
@@ -575,7 +906,8 @@ namespace RTT
     }
 
     void Logger::logflush() {
-        if (!d->maylog())
+        // in asynchronous mode, the drain thread flushes after each Logger::endl.
+        if (!d->maylog() || async)
             return;
         {
             // just flush all buffers, do not produce a new logline
@@ -601,12 +933,24 @@ namespace RTT
     void Logger::lognl() {
         if (!d->maylog())
             return;
+#ifdef ORO_LOGGER_ASYNC
+        if ( async ) {
+            d->commit(false);
+            return;
+        }
+#endif
         d->logit( Logger::nl );
      }
 
     void Logger::logendl() {
         if (!d->maylog())
             return;
+#ifdef ORO_LOGGER_ASYNC
+        if ( async ) {
+            d->commit(true);
+            return;
+        }
+#endif
         d->logit( Logger::endl );
      }
 
@@ -90,6 +90,10 @@ namespace RTT
      * is 6 or lower, these messages will not appear and do no harm to real-time performance.
      * You need to call @verbatim Logger::log().allowRealTime(); @endverbatim once in your program
      * to confirm this choice. AGAIN: THIS WILL BREAK REAL-TIME PERFORMANCE.
+     *
+     * Alternatively, switch the Logger to asynchronous mode with setAsynchronous().
+     * Each thread then composes its messages in its own lock-free ring of
+     * fixed size records, and a low priority thread formats and writes them.
      * @ingroup CoreLib
      */
     class RTT_API Logger
@@ -104,6 +108,10 @@ namespace RTT
         os::Mutex& inpguard;
         std::ostream& logline;
         std::ostream& fileline;
+        /**
+         * True in asynchronous mode.
+         */
+        volatile bool async;
     public:
 
         /**
@@ -246,6 +254,48 @@ namespace RTT
          */
         void setStdStream( std::ostream& stdos  );
 
+        /**
+         * What to do when a thread's ring of log records is full in
+         * asynchronous mode.
+         */
+        enum OverflowPolicy {
+            DropRecord,  //! Discard the message and count it in getDroppedRecords().
+            WaitForSpace //! Sleep until a record is written out. Do not use in real-time threads.
+        };
+
+        /**
+         * Switches between synchronous (the default) and asynchronous logging.
+         * In asynchronous mode, each thread composes its messages in its
+         * own ring of \a records log records, without taking a lock and
+         * without allocating memory once the thread logged its first message.
+         * A thread of the lowest priority prepends the time stamp, level and
+         * module to the messages and writes them out every \a period seconds.
+         * The module set by Logger::In is kept per thread in this mode.
+         * Messages longer than ORONUM_LOGGING_RECORD_SIZE are truncated.
+         *
+         * Switch modes when no other thread is logging, for example
+         * during application start-up.
+         * @param async true to switch to asynchronous mode, false to write out
+         * the pending records and return to synchronous mode.
+         * @param records The number of records of each thread.
+         * @param policy What to do when a thread runs out of records.
+         * @param period The period of the thread writing out the records.
+         * @return false if \a records is out of range or if asynchronous logging
+         * is not supported on this platform.
+         */
+        bool setAsynchronous(bool async, unsigned int records = 128, OverflowPolicy policy = DropRecord, Seconds period = 0.01);
+
+        /**
+         * Returns true if the Logger is in asynchronous mode.
+         */
+        bool isAsynchronous() const;
+
+        /**
+         * Returns the number of messages discarded in asynchronous mode
+         * because a thread ran out of records.
+         */
+        unsigned int getDroppedRecords() const;
+
         /**
          * Send (user defined) data into this logger. All data with lower priority than
          * the current loglevel will be discarded. If any loglevel (thus in or out)
@@ -329,6 +379,12 @@ namespace RTT
         bool mayLogStdOut() const;
         bool mayLogFile() const;
 
+        /**
+         * Returns the stream composing the calling thread's current
+         * message in asynchronous mode, or null if it is discarded.
+         */
+        std::ostream* asyncLine();
+
         Logger(std::ostream& str=std::cerr);
         ~Logger();
 
@@ -17,6 +17,13 @@ namespace RTT
         if ( !mayLog() )
             return *this;
 
+        if ( async ) {
+            std::ostream* line = this->asyncLine();
+            if ( line )
+                *line << t;
+            return *this;
+        }
+
         os::MutexLock lock( inpguard );
         if ( this->mayLogStdOut() )
             logline << t;
@@ -111,6 +118,18 @@ namespace RTT
     inline void Logger::setStdStream( std::ostream& ) {
     }
 
+    inline bool Logger::setAsynchronous(bool, unsigned int, OverflowPolicy, Seconds) {
+        return false;
+    }
+
+    inline bool Logger::isAsynchronous() const {
+        return false;
+    }
+
+    inline unsigned int Logger::getDroppedRecords() const {
+        return 0;
+    }
+
     inline Logger& Logger::operator<<( const std::string& ) {
         return *this;
     }
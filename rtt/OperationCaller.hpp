@@ -370,6 +370,17 @@ namespace RTT
                 this->impl->setCaller(caller);
         }
 
+        /**
+         * Preallocate \a depth invocation objects for send(), such that
+         * sending is allocation free as long as no more than \a depth
+         * SendHandles are in use. Call this when the OperationCaller is
+         * ready(), and again after assigning it another operation.
+         * @return false if not ready or if the operation is not local.
+         */
+        bool setSendPoolDepth(unsigned int depth) {
+            return this->impl && this->impl->setSendPoolDepth(depth);
+        }
+
         void disconnect()
         {
             this->impl.reset();
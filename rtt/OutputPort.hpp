@@ -73,9 +73,15 @@ namespace RTT
 
         bool do_write(typename base::ChannelElement<T>::param_t sample, const internal::ConnectionManager::ChannelDescriptor& descriptor)
         {
-            typename base::ChannelElement<T>::shared_ptr output
-                = boost::static_pointer_cast< base::ChannelElement<T> >(descriptor.get<1>());
-            if (output->write(sample))
+            // the descriptor keeps the channel alive, no need to take a reference.
+            base::ChannelElement<T>* output = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
+            if ( descriptor.get<2>().shared ) {
+                // only the first shared connection copies the sample of this write.
+                internal::ChannelSharedElement<T>* shared = static_cast< internal::ChannelSharedElement<T>* >( output->currentOutput() );
+                if ( shared && shared->write(sample, write_generation) )
+                    return false;
+            }
+            else if (output->write(sample))
                 return false;
             else
             {
@@ -84,10 +90,35 @@ namespace RTT
             }
         }
 
+        bool do_write_batch(std::vector<T> const& samples, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            base::ChannelElement<T>* output = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
+            if ( descriptor.get<2>().shared ) {
+                internal::ChannelSharedElement<T>* shared = static_cast< internal::ChannelSharedElement<T>* >( output->currentOutput() );
+                if ( shared && shared->writeBatch(samples, write_generation) )
+                    return false;
+            }
+            else if (output->writeBatch(samples))
+                return false;
+            log(Error) << "A channel of port " << getName() << " has been invalidated during writeBatch(), it will be removed" << endlog();
+            return true;
+        }
+
+        bool do_loan(const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            if ( loaned || !descriptor.get<2>().shared )
+                return false;
+            base::ChannelElement<T>* output = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
+            internal::ChannelSharedElement<T>* shared = static_cast< internal::ChannelSharedElement<T>* >( output->currentOutput() );
+            if ( shared && (loaned = shared->getStorage()->loan()) )
+                loan_storage = shared->getStorage();
+            // never removes the connection.
+            return false;
+        }
+
         bool do_init(typename base::ChannelElement<T>::param_t sample, const internal::ConnectionManager::ChannelDescriptor& descriptor)
         {
-            typename base::ChannelElement<T>::shared_ptr output
-                = boost::static_pointer_cast< base::ChannelElement<T> >(descriptor.get<1>());
+            base::ChannelElement<T>* output = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
             if (output->data_sample(sample))
                 return false;
             else
@@ -109,7 +140,8 @@ namespace RTT
             {
                 T const& initial_sample = sample->Get();
                 if ( channel_el_input->data_sample(initial_sample) ) {
-                    if ( has_last_written_value && policy.init )
+                    // shared connections were initialized by the ConnFactory.
+                    if ( has_last_written_value && policy.init && !policy.shared )
                         return channel_el_input->write(initial_sample);
                     return true;
                 } else {
@@ -135,6 +167,15 @@ namespace RTT
         // This is used to allow the use of the 'init' connection policy option
         bool keeps_last_written_value;
         typename base::DataObjectInterface<T>::shared_ptr sample;
+        /// Incremented by each call to write(), such that the shared
+        // connections only copy a sample once.
+        unsigned int write_generation;
+        /// The sample returned by loan(), or null.
+        T* loaned;
+        /// The shared storage that owns \c loaned, if any.
+        typename internal::ChannelSharedStorage<T>::shared_ptr loan_storage;
+        /// Returned by loan() if no shared storage can provide a sample.
+        T loan_sample;
 
         /**
          * You are not allowed to copy ports.
@@ -169,6 +210,8 @@ namespace RTT
             , keeps_next_written_value(false)
             , keeps_last_written_value(false)
             , sample( new base::DataObject<T>() )
+            , write_generation(0)
+            , loaned(0)
         {
             if (keep_last_written_value)
                 keepLastWrittenValue(true);
@@ -251,10 +294,91 @@ namespace RTT
                 this->sample->Set(sample);
             }
             has_last_written_value = keeps_last_written_value;
+            ++write_generation;
+
+            cmanager.delete_if( boost::bind(
+                        &OutputPort<T>::do_write, this, boost::ref(sample), boost::lambda::_1)
+                    );
+        }
+
+        /**
+         * Writes a batch of samples to all receivers (if any), in order.
+         * Each connection receives the whole batch in one call, such that
+         * a buffered connection stores it at once and signals its reader
+         * only once. A data connection only keeps the last sample.
+         * @param samples The new samples to send out.
+         */
+        void writeBatch(std::vector<T> const& samples)
+        {
+            if (samples.empty())
+                return;
+            if (keeps_last_written_value || keeps_next_written_value)
+            {
+                keeps_next_written_value = false;
+                has_initial_sample = true;
+                this->sample->Set(samples.back());
+            }
+            has_last_written_value = keeps_last_written_value;
+            ++write_generation;
+
+            cmanager.delete_if( boost::bind(
+                        &OutputPort<T>::do_write_batch, this, boost::ref(samples), boost::lambda::_1)
+                    );
+        }
+
+        /**
+         * Borrows a sample which can be filled in place and sent to all
+         * receivers with commit(). If the port has shared connections
+         * (ConnPolicy::shared), the sample lives in their storage and commit()
+         * publishes it without copying it. Otherwise, the sample is owned by
+         * this port and commit() behaves as write().
+         *
+         * The borrowed sample contains stale data and must be completely
+         * overwritten. Other writes to the shared connections are dropped
+         * until commit() is called, so loan() and commit() must be called
+         * from the thread that writes this port. Note that a port which keeps
+         * its last written value makes a copy in commit().
+         * @see keepLastWrittenValue()
+         * @return the sample to fill in, valid until commit().
+         */
+        T& loan()
+        {
+            if (!loaned) {
+                cmanager.delete_if( boost::bind(
+                            &OutputPort<T>::do_loan, this, boost::lambda::_1)
+                        );
+                if (!loaned)
+                    loaned = &loan_sample;
+            }
+            return *loaned;
+        }
+
+        /**
+         * Sends the sample returned by loan() to all receivers.
+         * Does nothing if loan() was not called.
+         */
+        void commit()
+        {
+            if (!loaned)
+                return;
+            T const& sample = *loaned;
+            if (keeps_last_written_value || keeps_next_written_value)
+            {
+                keeps_next_written_value = false;
+                has_initial_sample = true;
+                this->sample->Set(sample);
+            }
+            has_last_written_value = keeps_last_written_value;
+            ++write_generation;
 
+            // the connections sharing loan_storage only signal their reader.
+            if (loan_storage)
+                loan_storage->commit(write_generation);
             cmanager.delete_if( boost::bind(
                         &OutputPort<T>::do_write, this, boost::ref(sample), boost::lambda::_1)
                     );
+            loaned = 0;
+            loan_storage.reset();
         }
 
         void write(base::DataSourceBase::shared_ptr source)
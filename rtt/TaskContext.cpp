@@ -49,8 +49,9 @@
 
 #include "internal/DataSource.hpp"
 #include "internal/mystd.hpp"
-#include "internal/MWSRQueue.hpp"
+#include "os/CAS.hpp"
 #include "OperationCaller.hpp"
+#include "OutputPort.hpp"
 
 #include "rtt-config.h"
 
@@ -69,7 +70,6 @@ namespace RTT
 
     TaskContext::TaskContext(const std::string& name, TaskState initial_state /*= Stopped*/)
         :  TaskCore( initial_state)
-           ,portqueue( new MWSRQueue<PortInterface*>(64) )
            ,tcservice(new Service(name,this) ), tcrequests( new ServiceRequester(name,this) )
 #if defined(ORO_ACT_DEFAULT_SEQUENTIAL)
            ,our_act( new SequentialActivity( this->engine() ) )
@@ -82,7 +82,6 @@ namespace RTT
 
     TaskContext::TaskContext(const std::string& name, ExecutionEngine* parent, TaskState initial_state /*= Stopped*/ )
         :  TaskCore(parent, initial_state)
-           ,portqueue( new MWSRQueue<PortInterface*>(64) )
            ,tcservice(new Service(name,this) ), tcrequests( new ServiceRequester(name,this) )
 #if defined(ORO_ACT_DEFAULT_SEQUENTIAL)
            ,our_act( parent ? 0 : new SequentialActivity( this->engine() ) )
@@ -93,8 +92,33 @@ namespace RTT
         this->setup();
     }
 
+    namespace {
+        /**
+         * Writes the thread statistics of a component to its
+         * threadStatistics port in each execution cycle.
+         */
+        struct ThreadStatisticsPublisher : public base::ExecutableInterface
+        {
+            OutputPort<os::ThreadStatistics> port;
+
+            ThreadStatisticsPublisher()
+                : port("threadStatistics")
+            {
+                port.doc("The scheduling statistics of the thread of this component.");
+            }
+
+            bool execute() {
+                ActivityInterface* act = engine->getActivity();
+                if ( act && act->thread() )
+                    port.write( act->thread()->getStatistics() );
+                return true;
+            }
+        };
+    }
+
     void TaskContext::setup()
     {
+        statistics_publisher = 0;
         tcservice->setOwner(this);
         // from Service
         provides()->doc("The interface of this TaskContext.");
@@ -117,6 +141,11 @@ namespace RTT
         this->addOperation("update", &TaskContext::update, this, ClientThread).doc("Execute (call) the update method directly.\n Only succeeds if the task isRunning() and allowed by the Activity executing this task.");
 
         this->addOperation("trigger", &TaskContext::trigger, this, ClientThread).doc("Trigger the update method for execution in the thread of this task.\n Only succeeds if the task isRunning() and allowed by the Activity executing this task.");
+        this->addOperation("getThreadStatistics", &TaskContext::getThreadStatistics, this, ClientThread).doc("Get the scheduling statistics of the thread of this component.");
+        this->addOperation("resetThreadStatistics", &TaskContext::resetThreadStatistics, this, ClientThread).doc("Clear the scheduling statistics of the thread of this component.");
+        this->addOperation("publishThreadStatistics", &TaskContext::publishThreadStatistics, this, ClientThread).doc("Add or remove the threadStatistics port, which is written in each execution cycle.").arg("publish", "true to add the port, false to remove it.");
+        this->addOperation("getConnectionStatistics", &TaskContext::getConnectionStatistics, this, ClientThread).doc("Get the data flow statistics of the connections of all ports of this component.");
+        this->addOperation("resetConnectionStatistics", &TaskContext::resetConnectionStatistics, this, ClientThread).doc("Clear the data flow statistics of the connections of all ports of this component.");
         this->addOperation("loadService", &TaskContext::loadService, this, ClientThread).doc("Loads a service known to RTT into this component.").arg("service_name","The name with which the service is registered by in the PluginLoader.");
         // activity runs from the start.
         if (our_act)
@@ -127,6 +156,7 @@ namespace RTT
         {
             if (our_act)
                 our_act->stop();
+            publishThreadStatistics(false);
             // We don't call stop() or cleanup() here since this is
             // the responsibility of the subclass. Calling these functions
             // here would only lead to calling invalid virtual functions.
@@ -148,9 +178,64 @@ namespace RTT
             }
             // Do not call this->disconnect() !!!
             // Ports are probably already destructed by user code.
-            delete portqueue;
         }
 
+    os::ThreadStatistics TaskContext::getThreadStatistics() const
+    {
+        ActivityInterface* act = this->engine()->getActivity();
+        if ( act && act->thread() )
+            return act->thread()->getStatistics();
+        return os::ThreadStatistics();
+    }
+
+    void TaskContext::resetThreadStatistics()
+    {
+        ActivityInterface* act = this->engine()->getActivity();
+        if ( act && act->thread() )
+            act->thread()->resetStatistics();
+    }
+
+    std::vector<ConnectionStatistics> TaskContext::getConnectionStatistics() const
+    {
+        std::vector<ConnectionStatistics> result;
+        DataFlowInterface::Ports ports = this->ports()->getPorts();
+        for (DataFlowInterface::Ports::iterator it = ports.begin(); it != ports.end(); ++it) {
+            std::vector<ConnectionStatistics> stats = (*it)->getConnectionStatistics();
+            result.insert( result.end(), stats.begin(), stats.end() );
+        }
+        return result;
+    }
+
+    void TaskContext::resetConnectionStatistics()
+    {
+        DataFlowInterface::Ports ports = this->ports()->getPorts();
+        for (DataFlowInterface::Ports::iterator it = ports.begin(); it != ports.end(); ++it)
+            (*it)->resetConnectionStatistics();
+    }
+
+    bool TaskContext::publishThreadStatistics(bool publish)
+    {
+        if ( publish == (statistics_publisher != 0) )
+            return true;
+        if ( publish ) {
+            ThreadStatisticsPublisher* publisher = new ThreadStatisticsPublisher();
+            ports()->addPort( publisher->port );
+            if ( !this->engine()->runFunction( publisher ) ) {
+                ports()->removePort( publisher->port.getName() );
+                delete publisher;
+                return false;
+            }
+            statistics_publisher = publisher;
+        } else {
+            ThreadStatisticsPublisher* publisher = static_cast<ThreadStatisticsPublisher*>( statistics_publisher );
+            statistics_publisher = 0;
+            this->engine()->removeFunction( publisher );
+            ports()->removePort( publisher->port.getName() );
+            delete publisher;
+        }
+        return true;
+    }
+
     bool TaskContext::connectPorts( TaskContext* peer )
     {
         bool failure = false;
@@ -424,33 +509,53 @@ namespace RTT
 
     void TaskContext::dataOnPort(PortInterface* port)
     {
-        portqueue->enqueue( port );
-        this->getActivity()->trigger();
+        // only event ports call this function, and only the first
+        // signal since our last cycle needs to wake us up.
+        if ( os::CAS( &static_cast<InputPortInterface*>(port)->mevent_pending, 0, 1) )
+            this->getActivity()->trigger();
     }
 
     void TaskContext::dataOnPortCallback(InputPortInterface* port, TaskContext::SlotFunction callback) {
-        // user_callbacks will only be emitted from updateHook().
+        // user callbacks will only be emitted from updateHook().
         MutexLock lock(mportlock);
-        user_callbacks[port] = callback;
+        for (EventPorts::iterator it = eventports.begin(); it != eventports.end(); ++it)
+            if ( it->first == port ) {
+                it->second = callback;
+                return;
+            }
+        eventports.push_back( std::make_pair(port, callback) );
+        firedports.reserve( eventports.size() );
     }
 
     void TaskContext::dataOnPortRemoved(PortInterface* port) {
         MutexLock lock(mportlock);
-        UserCallbacks::iterator it = user_callbacks.find(port);
-        if (it != user_callbacks.end() ) {
-            user_callbacks.erase(it);
-        }
+        for (EventPorts::iterator it = eventports.begin(); it != eventports.end(); ++it)
+            if ( it->first == port ) {
+                it->first->mevent_pending = 0;
+                eventports.erase(it);
+                firedports.erase( remove( firedports.begin(), firedports.end(), port ), firedports.end() );
+                return;
+            }
     }
 
     void TaskContext::prepareUpdateHook()
     {
         MutexLock lock(mportlock);
-        PortInterface* port = 0;
-        while ( portqueue->dequeue( port ) == true ) {
-            UserCallbacks::iterator it = user_callbacks.find(port);
-            if (it != user_callbacks.end() )
-                it->second(port); // fire the user callback
+        firedports.clear();
+        for (EventPorts::iterator it = eventports.begin(); it != eventports.end(); ++it) {
+            // clear the flag before the callback reads the port, such that
+            // new data arriving during the callback triggers us again.
+            if ( it->first->mevent_pending && os::CAS( &it->first->mevent_pending, 1, 0) ) {
+                firedports.push_back( it->first );
+                if ( it->second )
+                    it->second( it->first ); // fire the user callback
+            }
         }
     }
+
+    bool TaskContext::isPortFired(InputPortInterface* port) const
+    {
+        return find( firedports.begin(), firedports.end(), port ) != firedports.end();
+    }
 }
 
@@ -46,10 +46,12 @@
 #include "DataFlowInterface.hpp"
 #include "ExecutionEngine.hpp"
 #include "base/TaskCore.hpp"
+#include "os/ThreadStatistics.hpp"
 #include <boost/make_shared.hpp>
 
 #include <string>
 #include <map>
+#include <vector>
 
 namespace RTT
 {
@@ -589,6 +591,63 @@ namespace RTT
          * Add a data flow connection from this task's ports to a peer's ports.
          */
         virtual bool connectPorts( TaskContext* peer );
+
+        /**
+         * Returns the data flow statistics of the connections of all
+         * ports of this component.
+         * @see base::PortInterface::getConnectionStatistics()
+         */
+        std::vector<ConnectionStatistics> getConnectionStatistics() const;
+
+        /**
+         * Clears the data flow statistics of the connections of all
+         * ports of this component.
+         */
+        void resetConnectionStatistics();
+
+        /**
+         * Returns the event ports that received new data since the
+         * previous execution cycle, in the order they were added.
+         * Multiple samples on one port are reported once. Only
+         * valid from within updateHook().
+         */
+        const std::vector<base::InputPortInterface*>& getFiredPorts() const {
+            return firedports;
+        }
+
+        /**
+         * Returns true if \a port is an event port that received new data
+         * since the previous execution cycle. Only valid from within
+         * updateHook().
+         */
+        bool isPortFired(base::InputPortInterface* port) const;
+        /** @} */
+
+        /**
+         * @name Thread statistics
+         * Inspect the scheduling quality of the thread of this component.
+         * @{
+         */
+        /**
+         * Returns the scheduling statistics of the thread that
+         * executes this component. They are empty if it has no
+         * thread or a thread that does not keep statistics.
+         */
+        os::ThreadStatistics getThreadStatistics() const;
+
+        /**
+         * Clears the scheduling statistics of the thread that
+         * executes this component.
+         */
+        void resetThreadStatistics();
+
+        /**
+         * Adds or removes the \a threadStatistics output port, to
+         * which the thread statistics are written in each execution
+         * cycle of this component.
+         * @return false if the port could not be added.
+         */
+        bool publishThreadStatistics(bool publish);
         /** @} */
 
     protected:
@@ -627,23 +686,27 @@ namespace RTT
         void setup();
 
         friend class DataFlowInterface;
-        internal::MWSRQueue<base::PortInterface*>* portqueue;
-        typedef std::map<base::PortInterface*, SlotFunction > UserCallbacks;
-        UserCallbacks user_callbacks;
+        /**
+         * The event ports with their (optional) user callback. Only
+         * modified with mportlock held.
+         */
+        typedef std::vector< std::pair<base::InputPortInterface*, SlotFunction> > EventPorts;
+        EventPorts eventports;
+        /**
+         * The event ports that fired in the current cycle. Its capacity
+         * is kept at eventports.size() such that it never allocates.
+         */
+        std::vector<base::InputPortInterface*> firedports;
 
         /**
          * This callback is called each time data arrived on an
-         * event port.
+         * event port. Only the first call since the previous cycle
+         * triggers our activity.
          */
         void dataOnPort(base::PortInterface* port);
         /**
-         * Called to inform us of the number of possible
-         * ports that will trigger a dataOnPort event.
-         * @return false if this->isRunning().
-         */
-        bool dataOnPortSize(unsigned int max);
-        /**
-         * Function to call in the thread of this component if data on the given port arrives.
+         * Registers an event port and the function to call in the thread of
+         * this component if data on the given port arrives. \a callback may be empty.
          */
         void dataOnPortCallback(base::InputPortInterface* port, SlotFunction callback);
         /**
@@ -681,6 +744,11 @@ namespace RTT
          * setActivity. By default, a extras::SequentialActivity is assigned.
          */
         base::ActivityInterface::shared_ptr our_act;
+
+        /**
+         * Writes the threadStatistics port, if published.
+         */
+        base::ExecutableInterface* statistics_publisher;
     };
 
     /**
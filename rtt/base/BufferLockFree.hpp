@@ -41,8 +41,8 @@
 #include "../os/oro_arch.h"
 #include "../os/CAS.hpp"
 #include "BufferInterface.hpp"
-#include "../internal/AtomicMWSRQueue.hpp"
-#include "../internal/TsPool.hpp"
+#include "../internal/PaddedMWSRQueue.hpp"
+#include "../internal/PaddedTsPool.hpp"
 #include <vector>
 
 #ifdef ORO_PRAGMA_INTERFACE
@@ -75,9 +75,9 @@ namespace RTT
         typedef T value_t;
     private:
         typedef T Item;
-        internal::AtomicMWSRQueue<Item*> bufs;
+        internal::PaddedMWSRQueue<Item*> bufs;
         // is mutable because of reference counting.
-        mutable internal::TsPool<Item> mpool;
+        mutable internal::PaddedTsPool<Item> mpool;
         const bool mcircular;
     public:
         /**
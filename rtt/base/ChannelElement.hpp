@@ -41,6 +41,7 @@
 
 #include <boost/intrusive_ptr.hpp>
 #include <boost/call_traits.hpp>
+#include <vector>
 #include "ChannelElementBase.hpp"
 #include "../FlowStatus.hpp"
 
@@ -71,6 +72,26 @@ namespace RTT { namespace base {
                     ChannelElementBase::getInput());
         }
 
+        /**
+         * Lock-free and refcount-free version of getOutput(), for use in the
+         * data path.
+         * @see ChannelElementBase::currentOutput()
+         */
+        ChannelElement<T>* currentOutput() const
+        {
+            return static_cast< ChannelElement<T>* >( ChannelElementBase::currentOutput() );
+        }
+
+        /**
+         * Lock-free and refcount-free version of getInput(), for use in the
+         * data path.
+         * @see ChannelElementBase::currentInput()
+         */
+        ChannelElement<T>* currentInput() const
+        {
+            return static_cast< ChannelElement<T>* >( ChannelElementBase::currentInput() );
+        }
+
         /**
          * Provides a data sample to initialize this connection.
          * This is used before the first write() in order to inform this
@@ -81,7 +102,7 @@ namespace RTT { namespace base {
          */
         virtual bool data_sample(param_t sample)
         {
-            typename ChannelElement<T>::shared_ptr output = boost::static_pointer_cast< ChannelElement<T> >(getOutput());
+            ChannelElement<T>* output = this->currentOutput();
             if (output)
                 return output->data_sample(sample);
             return false;
@@ -89,7 +110,7 @@ namespace RTT { namespace base {
 
         virtual value_t data_sample()
         {
-            typename ChannelElement<T>::shared_ptr input = boost::static_pointer_cast< ChannelElement<T> >(getInput());
+            ChannelElement<T>* input = this->currentInput();
             if (input)
                 return input->data_sample();
             return value_t();
@@ -102,12 +123,26 @@ namespace RTT { namespace base {
          */
         virtual bool write(param_t sample)
         {
-            typename ChannelElement<T>::shared_ptr output = boost::static_pointer_cast< ChannelElement<T> >(getOutput());
+            ChannelElement<T>* output = this->currentOutput();
             if (output)
                 return output->write(sample);
             return false;
         }
 
+        /** Writes the \a samples on this connection, in order. Elements that
+         * store samples override this to store the whole batch at once and
+         * signal only once, the others write the samples one by one.
+         *
+         * @returns false if an error occured that requires the channel to be invalidated.
+         */
+        virtual bool writeBatch(std::vector<value_t> const& samples)
+        {
+            for (typename std::vector<value_t>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+                if ( !this->write(*it) )
+                    return false;
+            return true;
+        }
+
         /** Reads a sample from the connection. \a sample is a reference which
          * will get updated if a sample is available. The method returns true
          * if a sample was available, and false otherwise. If false is returned,
@@ -115,12 +150,46 @@ namespace RTT { namespace base {
          */
         virtual FlowStatus read(reference_t sample, bool copy_old_data)
         {
-            typename ChannelElement<T>::shared_ptr input = this->getInput();
+            ChannelElement<T>* input = this->currentInput();
             if (input)
                 return input->read(sample, copy_old_data);
             else
                 return NoData;
         }
+
+        /** Reads all new samples from the connection and appends them to
+         * \a samples. Elements that store samples override this to drain
+         * their storage at once, the others read the samples one by one.
+         *
+         * @return NewData if at least one sample was appended, OldData or
+         * NoData as returned by read() otherwise.
+         */
+        virtual FlowStatus readAll(std::vector<value_t>& samples)
+        {
+            value_t sample = value_t();
+            FlowStatus result = this->read(sample, false);
+            if (result != NewData)
+                return result;
+            do {
+                samples.push_back(sample);
+            } while ( this->read(sample, false) == NewData );
+            return NewData;
+        }
+
+        /** Reads a sample from the connection without copying it. \a sample
+         * is set to point to the sample in the connection's storage if a sample
+         * is available, and remains valid until the next read(), readLoaned()
+         * or clear() on this connection. Elements that store samples override
+         * this method, the others forward it to their input.
+         */
+        virtual FlowStatus readLoaned(value_t const*& sample)
+        {
+            ChannelElement<T>* input = this->currentInput();
+            if (input)
+                return input->readLoaned(sample);
+            else
+                return NoData;
+        }
     };
 }}
 
@@ -45,6 +45,7 @@
 #include <boost/call_traits.hpp>
 
 #include <rtt/os/Mutex.hpp>
+#include "../rtt-fwd.hpp"
 #include "rtt-base-fwd.hpp"
 #include "../internal/rtt-internal-fwd.hpp"
 
@@ -54,8 +55,13 @@ namespace RTT { namespace base {
      * ChannelElementBase objects.
      *
      * ChannelElementBase objects are refcounted. In the chain, an element
-     * maintains the refcount for its successor, and holds a simple pointer to
-     * its predecessor.
+     * maintains a refcount for its successor and for its predecessor. These
+     * links are published as plain pointers, such that the data path
+     * (write(), read(), signal(),...) can walk the chain without taking a lock
+     * or touching the refcounts. Only setOutput() and disconnect() modify the
+     * links and the references are only dropped at the end of disconnect(),
+     * when both ports have removed the connection from their
+     * ConnectionManager.
      */
     class RTT_API ChannelElementBase
     {
@@ -67,11 +73,21 @@ namespace RTT { namespace base {
         friend void RTT_API intrusive_ptr_add_ref( ChannelElementBase* e );
         friend void RTT_API intrusive_ptr_release( ChannelElementBase* e );
 
-        shared_ptr input;
-        shared_ptr output;
+        ChannelElementBase* volatile input;
+        ChannelElementBase* volatile output;
 
+        /**
+         * Serializes topology changes and the refcounted getInput() and
+         * getOutput() accessors. The data path never takes this lock.
+         */
         RTT::os::Mutex inout_lock;
 
+        /**
+         * Atomically replaces \a link with \a value and returns the
+         * previous value. The reference held by the link is not modified.
+         */
+        static ChannelElementBase* exchangeLink(ChannelElementBase* volatile* link, ChannelElementBase* value);
+
     protected:
         /** Increases the reference count */
         void ref();
@@ -102,6 +118,16 @@ namespace RTT { namespace base {
          */
         ChannelElementBase::shared_ptr getInput();
 
+        /**
+         * Returns the current input channel element, without locking and
+         * without modifying its refcount. This is the accessor used by the
+         * data path. The returned element is guaranteed to be valid as long
+         * as the connection is registered in the ConnectionManager of one of
+         * its ports.
+         * @return the input element or null if none.
+         */
+        ChannelElementBase* currentInput() const { return input; }
+
         /**
          * Returns the first input channel element of this connection.
          * Will return the channel element the furthest away from the input port,
@@ -116,6 +142,14 @@ namespace RTT { namespace base {
          */
         ChannelElementBase::shared_ptr getOutput();
 
+        /**
+         * Returns the next channel element in the channel's propagation
+         * direction, without locking and without modifying its refcount.
+         * @see currentInput() for the validity of the returned pointer.
+         * @return the output element or null if none.
+         */
+        ChannelElementBase* currentOutput() const { return output; }
+
         /**
          * Returns the last output channel element of this connection.
          * Will return the channel element the furthest away from the output port,
@@ -176,6 +210,18 @@ namespace RTT { namespace base {
          * @return null if no ConnID is associated with this element.
          */
         virtual internal::ConnID* getConnID() const;
+
+        /**
+         * Fills in the counters of \a stats if this element stores
+         * the data of the connection.
+         * @return false if this element keeps no statistics.
+         */
+        virtual bool getStatistics(ConnectionStatistics& stats) const;
+
+        /**
+         * Clears the statistics kept by this element, if any.
+         */
+        virtual void resetStatistics();
     };
 
     void RTT_API intrusive_ptr_add_ref( ChannelElementBase* e );
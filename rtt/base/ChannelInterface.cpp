@@ -39,22 +39,36 @@
 #include "../internal/Channels.hpp"
 #include "../os/Atomic.hpp"
 #include "../os/MutexLock.hpp"
+#include "../os/CAS.hpp"
 
 using namespace RTT;
 using namespace RTT::detail;
 
 ChannelElementBase::ChannelElementBase()
-    : input(0)
-
+    : input(0), output(0)
 {
     ORO_ATOMIC_SETUP(&refcount,0);
 }
 
 ChannelElementBase::~ChannelElementBase()
 {
+    // drop the references of links that were never disconnected.
+    if (input)
+        intrusive_ptr_release(input);
+    if (output)
+        intrusive_ptr_release(output);
     ORO_ATOMIC_CLEANUP(&refcount);
 }
 
+ChannelElementBase* ChannelElementBase::exchangeLink(ChannelElementBase* volatile* link, ChannelElementBase* value)
+{
+    ChannelElementBase* old;
+    do {
+        old = *link;
+    } while ( !os::CAS(link, old, value) );
+    return old;
+}
+
 ChannelElementBase::shared_ptr ChannelElementBase::getInput()
 { RTT::os::MutexLock lock(inout_lock);
     return ChannelElementBase::shared_ptr(input);
@@ -67,9 +81,24 @@ ChannelElementBase::shared_ptr ChannelElementBase::getOutput()
 
 void ChannelElementBase::setOutput(shared_ptr output)
 {
-    this->output = output;
-    if (output)
-        output->input = this;
+    ChannelElementBase* old_input = 0;
+    ChannelElementBase* old_output = 0;
+    if (output) {
+        // the new output's input link holds a reference to this.
+        RTT::os::MutexLock lock(output->inout_lock);
+        intrusive_ptr_add_ref(this);
+        old_input = exchangeLink(&output->input, this);
+    }
+    { RTT::os::MutexLock lock(inout_lock);
+        if (output)
+            intrusive_ptr_add_ref(output.get());
+        old_output = exchangeLink(&this->output, output.get());
+    }
+    // release outside the locks, this may delete elements.
+    if (old_input)
+        intrusive_ptr_release(old_input);
+    if (old_output)
+        intrusive_ptr_release(old_output);
 }
 
 void ChannelElementBase::disconnect(bool forward)
@@ -87,10 +116,18 @@ void ChannelElementBase::disconnect(bool forward)
             input->disconnect(false);
     }
 
+    // Both ports have removed this connection at this point, so no
+    // data path can still be walking the chain and we can drop the links.
+    ChannelElementBase* old_input;
+    ChannelElementBase* old_output;
     { RTT::os::MutexLock lock(inout_lock);
-        this->input = 0;
-        this->output = 0;
+        old_input = exchangeLink(&this->input, 0);
+        old_output = exchangeLink(&this->output, 0);
     }
+    if (old_input)
+        intrusive_ptr_release(old_input);
+    if (old_output)
+        intrusive_ptr_release(old_output);
 }
 
 ChannelElementBase::shared_ptr ChannelElementBase::getInputEndPoint()
@@ -107,7 +144,7 @@ ChannelElementBase::shared_ptr ChannelElementBase::getOutputEndPoint()
 bool ChannelElementBase::inputReady()
 {
     // we go against the data stream
-    shared_ptr input = getInput();
+    ChannelElementBase* input = currentInput();
     if (input)
         return input->inputReady();
     return false;
@@ -115,14 +152,14 @@ bool ChannelElementBase::inputReady()
 
 void ChannelElementBase::clear()
 {
-    shared_ptr input = getInput();
+    ChannelElementBase* input = currentInput();
     if (input)
         input->clear();
 }
 
 bool ChannelElementBase::signal()
 {
-    shared_ptr output = getOutput();
+    ChannelElementBase* output = currentOutput();
     if (output)
         return output->signal();
     return true;
@@ -136,6 +173,13 @@ internal::ConnID* ChannelElementBase::getConnID() const {
     return 0;
 }
 
+bool ChannelElementBase::getStatistics(ConnectionStatistics& stats) const {
+    return false;
+}
+
+void ChannelElementBase::resetStatistics() {
+}
+
 void ChannelElementBase::ref()
 {
     oro_atomic_inc(&refcount);
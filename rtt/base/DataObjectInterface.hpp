@@ -95,8 +95,9 @@ namespace RTT
          * Set the data to a certain value.
          *
          * @param push The data which must be set.
+         * @return false if the data could not be stored and was dropped.
          */
-        virtual void Set( const DataType& push ) = 0;
+        virtual bool Set( const DataType& push ) = 0;
 
         /**
          * Provides a data sample to initialize this data object.
@@ -187,8 +187,10 @@ namespace RTT
          * Set the data to a certain value (non blocking).
          *
          * @param push The data which must be set.
+         * @return false if all buffers were in use by readers, in which
+         * case \a push is dropped.
          */
-        virtual void Set( const DataType& push )
+        virtual bool Set( const DataType& push )
         {
             /**
              * This method can not be called concurrently (only one
@@ -207,12 +209,13 @@ namespace RTT
                 {
                     write_ptr = write_ptr->next;
                     if (write_ptr == wrote_ptr)
-                        return; // nothing found, to many readers !
+                        return false; // nothing found, to many readers !
                 }
 
             // we will be able to move, so replace read_ptr
             read_ptr  = wrote_ptr;
             write_ptr = write_ptr->next; // we checked this in the while loop
+            return true;
         }
 
         virtual void data_sample( const DataType& sample ) {
@@ -81,7 +81,7 @@ namespace RTT
 
         virtual DataType Get() const { DataType cache;  Get(cache); return cache; }
 
-        virtual void Set( const DataType& push ) { os::MutexLock locker(lock); data = push; }
+        virtual bool Set( const DataType& push ) { os::MutexLock locker(lock); data = push; return true; }
 
         virtual void data_sample( const DataType& sample ) {
             Set(sample);
@@ -0,0 +1,188 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  DataObjectSeqLock.hpp
+
+                        DataObjectSeqLock.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef CORELIB_DATAOBJECT_SEQ_LOCK_HPP
+#define CORELIB_DATAOBJECT_SEQ_LOCK_HPP
+
+
+#include "../os/oro_arch.h"
+#include "DataObjectInterface.hpp"
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+
+namespace RTT
+{ namespace base {
+
+    /**
+     * Tells if a DataObjectSeqLock can be used for type \a T, which
+     * requires that a copy of \a T, which is overwritten while
+     * it is being copied, can be made and discarded without side effects.
+     * This is assumed for all types with a trivial copy constructor and
+     * destructor. You may specialize it for other types that only contain
+     * plain data, for example fixed size matrices, or to exclude a type
+     * with a non trivial assignment operator.
+     */
+    template<class T>
+    struct is_seqlock_copyable
+        : public boost::integral_constant<bool,
+                                          boost::has_trivial_copy<T>::value &&
+                                          boost::has_trivial_destructor<T>::value >
+    {};
+
+    /**
+     * @brief This DataObject is a wait-free implementation for
+     * trivially copyable types, with one writer and any number of readers.
+     *
+     * The data is kept in two buffers, each guarded by a sequence
+     * number which is odd while the writer modifies the buffer.
+     * The writer always writes the buffer that readers are not pointed
+     * to and then points the readers to it, so it never fails and never
+     * waits. A reader copies the data and retries only when the
+     * writer modified the buffer during the copy, which requires two
+     * writes during one read. Readers do not modify shared state.
+     *
+     * @verbatim
+     * The following Truth table applies when a Low Priority thread is
+     * preempted by a High Priority thread :
+     *
+     *   L\H | Set | Get |
+     *   Set | NA  | Ok  |
+     *   Get | Ok  | Ok  |
+     *
+     * legend : L : Low Priority thread
+     *          H : High Priority thread
+     *          NA : Not allowed !
+     * @endverbatim
+     * @see is_seqlock_copyable for the types that can be used.
+     * @ingroup PortBuffers
+     */
+    template<class T>
+    class DataObjectSeqLock
+        : public DataObjectInterface<T>
+    {
+    public:
+        /**
+         * The type of the data.
+         */
+        typedef T DataType;
+    private:
+        struct DataBuf {
+            DataBuf()
+                : seq(0), data()
+            {}
+            volatile unsigned int seq;
+            DataType data;
+        };
+
+        /**
+         * The buffer readers read from.
+         */
+        DataBuf* volatile read_ptr;
+
+        DataBuf data[2];
+    public:
+        /**
+         * Construct a DataObjectSeqLock.
+         *
+         * @param initial_value The initial value of this DataObject.
+         */
+        DataObjectSeqLock( const T& initial_value = T() )
+            : read_ptr(&data[0])
+        {
+            data_sample(initial_value);
+        }
+
+        /**
+         * Get a copy of the data.
+         *
+         * @return A copy of the data.
+         */
+        virtual DataType Get() const {DataType cache; Get(cache); return cache; }
+
+        /**
+         * Get a copy of the Data.
+         *
+         * @param pull A copy of the data.
+         */
+        virtual void Get( DataType& pull ) const
+        {
+            while ( true ) {
+                const DataBuf* reading = read_ptr;
+                unsigned int seq = reading->seq;
+                oro_smp_mb();
+                // an odd sequence number means that the writer lapped us
+                // and is writing this buffer.
+                if ( seq & 1 )
+                    continue;
+                pull = reading->data;
+                oro_smp_mb();
+                if ( seq == reading->seq )
+                    return;
+            }
+        }
+
+        /**
+         * Set the data to a certain value (wait-free).
+         * This method can not be called concurrently (only one
+         * producer).
+         *
+         * @param push The data which must be set.
+         */
+        virtual bool Set( const DataType& push )
+        {
+            DataBuf* writing = read_ptr == &data[0] ? &data[1] : &data[0];
+            writing->seq = writing->seq + 1;
+            oro_smp_mb();
+            writing->data = push;
+            oro_smp_mb();
+            writing->seq = writing->seq + 1;
+            read_ptr = writing;
+            return true;
+        }
+
+        virtual void data_sample( const DataType& sample ) {
+            data[0].data = sample;
+            data[1].data = sample;
+            oro_smp_mb();
+        }
+    };
+}}
+
+#endif
@@ -59,6 +59,7 @@ InputPortInterface::InputPortInterface(std::string const& name, ConnPolicy const
 #else
  , msignal_interface(false)
 #endif
+  , mevent_pending(0)
 {}
 
 InputPortInterface::~InputPortInterface()
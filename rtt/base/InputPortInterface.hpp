@@ -77,6 +77,13 @@ namespace RTT
          */
         void signal();
 #endif
+        /**
+         * Set by the TaskContext when this event port signalled new data,
+         * cleared when the TaskContext processed it in its next cycle.
+         * It coalesces all signals in between into one trigger.
+         */
+        volatile int mevent_pending;
+        friend class RTT::TaskContext;
 
         InputPortInterface(const InputPortInterface& orig);
     public:
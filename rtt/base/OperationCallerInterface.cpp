@@ -40,6 +40,11 @@ ExecutionEngine* OperationCallerInterface::getMessageProcessor() const
 }
 
 
+bool OperationCallerInterface::setSendPoolDepth(unsigned int depth)
+{
+    return false;
+}
+
 // report an error if an exception was thrown while calling exec()
 void OperationCallerInterface::reportError() {
     // This localOperation was added to a TaskContext or to a Service owned by a TaskContext
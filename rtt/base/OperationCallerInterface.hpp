@@ -73,6 +73,15 @@ namespace RTT
              */
             void reportError();
 
+            /**
+             * Preallocate \a depth invocation objects for sending this
+             * operation, such that send() does not allocate memory as long
+             * as no more than \a depth SendHandles are in use. A depth of
+             * zero releases the preallocated objects.
+             * @return false if this caller does not support preallocation.
+             */
+            virtual bool setSendPoolDepth(unsigned int depth);
+
             /**
              * Helpful function to tell us if this operations is to be sent or not.
              */
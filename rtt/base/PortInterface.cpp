@@ -40,6 +40,7 @@
 #include "../Service.hpp"
 #include "../OperationCaller.hpp"
 #include "../internal/ConnFactory.hpp"
+#include "../internal/ConnectionManager.hpp"
 
 using namespace RTT;
 using namespace RTT::detail;
@@ -82,12 +83,29 @@ Service* PortInterface::createPortObject()
 
     typedef void (PortInterface::*disconnect_all)();
     to->addSynchronousOperation("disconnect", static_cast<disconnect_all>(&PortInterface::disconnect), this).doc("Disconnects this port from any connection it is part of.");
+    to->addSynchronousOperation("getConnectionStatistics", &PortInterface::getConnectionStatistics, this).doc("Returns the data flow statistics of each connection of this port.");
+    to->addSynchronousOperation("resetConnectionStatistics", &PortInterface::resetConnectionStatistics, this).doc("Clears the data flow statistics of the connections of this port.");
     return to;
 #else
     return 0;
 #endif
 }
 
+std::vector<ConnectionStatistics> PortInterface::getConnectionStatistics() const
+{
+    const internal::ConnectionManager* manager = getManager();
+    if (manager)
+        return manager->getStatistics();
+    return std::vector<ConnectionStatistics>();
+}
+
+void PortInterface::resetConnectionStatistics()
+{
+    const internal::ConnectionManager* manager = getManager();
+    if (manager)
+        manager->resetStatistics();
+}
+
 void PortInterface::setInterface(DataFlowInterface* dfi) {
     iface = dfi;
 }
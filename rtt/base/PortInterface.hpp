@@ -40,8 +40,10 @@
 #define ORO_EXECUTION_PORT_INTERFACE_HPP
 
 #include <string>
+#include <vector>
 #include "../internal/rtt-internal-fwd.hpp"
 #include "../ConnPolicy.hpp"
+#include "../ConnectionStatistics.hpp"
 #include "../internal/ConnID.hpp"
 #include "ChannelElementBase.hpp"
 #include "../types/rtt-types-fwd.hpp"
@@ -113,6 +115,17 @@ namespace RTT
          */
         virtual bool disconnect(PortInterface* port) = 0;
 
+        /**
+         * Returns the data flow statistics of the connections of this
+         * port of which the data is stored in this process.
+         */
+        std::vector<ConnectionStatistics> getConnectionStatistics() const;
+
+        /**
+         * Clears the data flow statistics of all connections of this port.
+         */
+        void resetConnectionStatistics();
+
         /** Returns true if this port is located on this process, and false
          * otherwise
          */
@@ -0,0 +1,253 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  PoolActivity.cpp
+
+                        PoolActivity.cpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PoolActivity.hpp"
+#include "../os/MainThread.hpp"
+#include "../os/CAS.hpp"
+#include "../os/fosi.h"
+
+namespace RTT {
+    using namespace extras;
+    using namespace base;
+
+    PoolActivity::PoolActivity( ThreadPoolPtr p, RunnableInterface* run /*= 0*/ )
+        : ActivityInterface(run), pool(p), state(Idle), active(false), enabled(false), worker(0)
+    {
+        oro_atomic_set(&users, 0);
+    }
+
+    PoolActivity::PoolActivity( int scheduler, int priority, RunnableInterface* run /*= 0*/ )
+        : ActivityInterface(run), pool( ThreadPool::Instance(scheduler, priority) ),
+          state(Idle), active(false), enabled(false), worker(0)
+    {
+        oro_atomic_set(&users, 0);
+    }
+
+    PoolActivity::~PoolActivity()
+    {
+        stop();
+        // the pool may not refer to us any more once we're gone.
+        os::ThreadInterface* w = worker;
+        if ( !w || !w->isSelf() )
+            waitForWorkers();
+    }
+
+    ThreadPoolPtr PoolActivity::getThreadPool() const
+    {
+        return pool;
+    }
+
+    Seconds PoolActivity::getPeriod() const
+    {
+        return 0.0;
+    }
+
+    bool PoolActivity::setPeriod(Seconds s) {
+        if ( s == 0.0)
+            return true;
+        return false;
+    }
+
+    unsigned PoolActivity::getCpuAffinity() const
+    {
+        return pool->getCpuAffinity();
+    }
+
+    bool PoolActivity::setCpuAffinity(unsigned cpu)
+    {
+        // the affinity is a property of the pool.
+        return false;
+    }
+
+    os::ThreadInterface* PoolActivity::thread()
+    {
+        os::ThreadInterface* w = worker;
+        if ( w )
+            return w;
+        // Not running: any worker that is not the caller, such that
+        // callers wait for us instead of processing our messages.
+        for (unsigned int i = 0; i != pool->getWorkerCount(); ++i)
+            if ( !pool->getWorker(i)->isSelf() )
+                return pool->getWorker(i);
+        return os::MainThread::Instance();
+    }
+
+    bool PoolActivity::initialize()
+    {
+        return true;
+    }
+
+    void PoolActivity::step()
+    {
+    }
+
+    void PoolActivity::finalize()
+    {
+    }
+
+    bool PoolActivity::start()
+    {
+        if ( active )
+            return false;
+
+        active = true;
+        if ( runner ? !runner->initialize() : !this->initialize() ) {
+            active = false;
+            return false;
+        }
+
+        enabled = true;
+        // like a non periodic Activity, execute step() once after start.
+        trigger();
+        return true;
+    }
+
+    bool PoolActivity::stop()
+    {
+        if ( !active )
+            return false;
+        // the CAS also orders the store of enabled before reading state in waitForWorkers().
+        if ( !os::CAS(&enabled, true, false) )
+            return false;
+
+        // stop() from within our own step() can not wait for step() to return.
+        os::ThreadInterface* w = worker;
+        if ( !w || !w->isSelf() )
+            waitForWorkers();
+
+        if (runner)
+            runner->finalize();
+        else
+            this->finalize();
+        active = false;
+        return true;
+    }
+
+    void PoolActivity::waitForWorkers()
+    {
+        // read state before users: work() holds users while it leaves the Running state.
+        while ( state != Idle || oro_atomic_read(&users) != 0 ) {
+            // a worker which waits for a queued activity executes
+            // queued work itself, in case it is the last worker.
+            if ( !pool->help() ) {
+                TIME_SPEC ts = ticks2timespec( nano2ticks(100000) );
+                rtos_nanosleep( &ts, 0 );
+            }
+        }
+    }
+
+    bool PoolActivity::isRunning() const
+    {
+        return state == Running || state == Retriggered;
+    }
+
+    bool PoolActivity::isPeriodic() const
+    {
+        return false;
+    }
+
+    bool PoolActivity::isActive() const
+    {
+        return active;
+    }
+
+    bool PoolActivity::execute()
+    {
+        return false;
+    }
+
+    bool PoolActivity::trigger()
+    {
+        bool result = false;
+        oro_atomic_inc(&users);
+        if ( enabled ) {
+            result = true;
+            while ( true ) {
+                int s = state;
+                if ( s == Idle ) {
+                    if ( os::CAS(&state, (int)Idle, (int)Queued) ) {
+                        if ( !pool->schedule(this) ) {
+                            state = Idle;
+                            result = false;
+                        }
+                        break;
+                    }
+                } else if ( s == Running ) {
+                    // the worker executes step() once more when it's done.
+                    if ( os::CAS(&state, (int)Running, (int)Retriggered) )
+                        break;
+                } else {
+                    // Queued or Retriggered: a step() will follow anyway.
+                    break;
+                }
+            }
+        }
+        oro_atomic_dec(&users);
+        return result;
+    }
+
+    void PoolActivity::work( os::ThreadInterface* w )
+    {
+        // we are the only queued instance, so only we leave the Queued state.
+        oro_atomic_inc(&users);
+        if ( enabled ) {
+            state = Running;
+            worker = w;
+            if (runner)
+                runner->loop();
+            else
+                this->step();
+            worker = 0;
+            if ( os::CAS(&state, (int)Running, (int)Idle) ) {
+                // a trigger() may have been missed by runner->step(),
+                // see SequentialActivity::trigger().
+                if ( enabled && runner && runner->hasWork() )
+                    trigger();
+            } else if ( enabled ) {
+                // Retriggered
+                state = Queued;
+                if ( !pool->schedule(this) )
+                    state = Idle;
+            } else
+                state = Idle;
+        } else
+            state = Idle;
+        oro_atomic_dec(&users);
+    }
+}
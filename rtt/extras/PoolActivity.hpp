@@ -0,0 +1,178 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  PoolActivity.hpp
+
+                        PoolActivity.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_POOL_ACTIVITY_HPP
+#define ORO_POOL_ACTIVITY_HPP
+
+#include "../base/ActivityInterface.hpp"
+#include "../base/RunnableInterface.hpp"
+#include "../os/oro_arch.h"
+#include "ThreadPool.hpp"
+
+namespace RTT
+{ namespace extras {
+
+    /**
+     * @brief A non periodic activity which is executed by the worker
+     * threads of a ThreadPool instead of by its own thread.
+     *
+     * Many components can share a few workers this way. Each trigger()
+     * queues the activity once in the pool and the next free worker
+     * executes step(). The step() of one PoolActivity never runs
+     * concurrently with itself: a trigger which arrives while step() is
+     * running is remembered and causes exactly one more step() after
+     * the current one.
+     *
+     * The scheduler, priority and CPU affinity are those of the pool.
+     *
+     * \section ExecReact Reactions to execute():
+     * Always returns false.
+     *
+     * \section TrigReact Reactions to trigger():
+     * Queues the activity in the pool, such that step() is executed
+     * by one of the workers.
+     *
+     * @ingroup CoreLibActivities
+     */
+    class RTT_API PoolActivity
+        :public base::ActivityInterface
+    {
+    public:
+        /**
+         * Create an activity which runs in the workers of \a pool.
+         * @param pool The pool which executes this activity.
+         * @param run Run this instance.
+         */
+        PoolActivity( ThreadPoolPtr pool, base::RunnableInterface* run = 0 );
+
+        /**
+         * Create an activity which runs in the shared pool with the
+         * given \a scheduler and \a priority.
+         * @param scheduler The scheduler of the workers.
+         * @param priority The priority of the workers.
+         * @param run Run this instance.
+         * @see ThreadPool::Instance
+         */
+        PoolActivity( int scheduler, int priority, base::RunnableInterface* run = 0 );
+
+        /**
+         * Stops the activity and waits until the pool no longer
+         * refers to it.
+         */
+        ~PoolActivity();
+
+        /**
+         * Returns the pool which executes this activity.
+         */
+        ThreadPoolPtr getThreadPool() const;
+
+        Seconds getPeriod() const;
+
+        bool setPeriod(Seconds s);
+
+        unsigned getCpuAffinity() const;
+
+        bool setCpuAffinity(unsigned cpu);
+
+        /**
+         * Returns the worker which is executing step(), or, when
+         * idle, a worker of the pool which is not the caller.
+         */
+        os::ThreadInterface* thread();
+
+        virtual bool initialize();
+        virtual void step();
+        virtual void finalize();
+
+        bool start();
+
+        bool stop();
+
+        bool isRunning() const;
+
+        bool isPeriodic() const;
+
+        bool isActive() const;
+
+        bool execute();
+
+        bool trigger();
+
+    private:
+        friend class ThreadPool;
+
+        /**
+         * Called by \a worker to execute one step() after this
+         * activity was taken from a queue of the pool.
+         */
+        void work( os::ThreadInterface* worker );
+
+        /**
+         * Waits until no worker and no trigger() uses this
+         * activity any more.
+         */
+        void waitForWorkers();
+
+        /**
+         * Idle: not queued, Queued: waits for a worker, Running: a
+         * worker executes step(), Retriggered: trigger() was called
+         * during step().
+         */
+        enum State { Idle, Queued, Running, Retriggered };
+
+        ThreadPoolPtr pool;
+        int volatile state;
+        bool volatile active;
+        /**
+         * True from the end of start() until stop(): only then
+         * trigger() queues this activity.
+         */
+        bool volatile enabled;
+        os::ThreadInterface* volatile worker;
+        /**
+         * Counts the trigger() calls in progress, stop() waits for
+         * them before it finalizes.
+         */
+        oro_atomic_t users;
+    };
+
+}}
+
+
+#endif
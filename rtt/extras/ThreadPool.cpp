@@ -0,0 +1,257 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  ThreadPool.cpp
+
+                        ThreadPool.cpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "ThreadPool.hpp"
+#include "PoolActivity.hpp"
+
+#include "../os/Thread.hpp"
+#include "../internal/AtomicQueue.hpp"
+#include "../Logger.hpp"
+
+#include <sstream>
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
+namespace RTT {
+    using namespace extras;
+    using namespace base;
+    using namespace std;
+
+    /**
+     * A non periodic thread which executes the activities queued
+     * on its own queue or stolen from the other workers of the pool.
+     */
+    class ThreadPool::Worker
+        : public os::Thread
+    {
+    public:
+        ThreadPool* pool;
+        unsigned int id;
+        internal::AtomicQueue<PoolActivity*> queue;
+        bool volatile quit;
+
+        Worker(ThreadPool* p, unsigned int i, int scheduler, int priority, unsigned cpu_affinity, const std::string& name)
+            : Thread(scheduler, priority, 0.0, cpu_affinity, name),
+              pool(p), id(i), queue(MAX_ACTIVITIES), quit(false)
+        {}
+
+        ~Worker()
+        {
+            this->stop();
+        }
+
+        void loop()
+        {
+            while ( !quit ) {
+                PoolActivity* a = 0;
+                if ( pool->take(id, a) )
+                    a->work( this );
+                else
+                    pool->work_sem.wait();
+            }
+        }
+
+        bool breakLoop()
+        {
+            quit = true;
+            pool->work_sem.signal();
+            return true;
+        }
+    };
+
+    ThreadPool::ThreadPoolList ThreadPool::ThreadPools;
+
+    ThreadPoolPtr ThreadPool::Instance(int scheduler, int priority, unsigned cpu_affinity)
+    {
+        os::CheckPriority(scheduler, priority);
+        ThreadPoolList::iterator it = ThreadPools.begin();
+        while ( it != ThreadPools.end() ) {
+            ThreadPoolPtr pptr = it->lock();
+            // detect old pointer.
+            if ( !pptr ) {
+                ThreadPools.erase(it);
+                it = ThreadPools.begin();
+                continue;
+            }
+            if ( pptr->getScheduler() == scheduler && pptr->getPriority() == priority && pptr->mcpu_affinity == cpu_affinity ) {
+                return pptr;
+            }
+            ++it;
+        }
+        ThreadPoolPtr ret( new ThreadPool(scheduler, priority, 0, cpu_affinity, "ThreadPoolInstance") );
+        ThreadPools.push_back( ret );
+        return ret;
+    }
+
+    ThreadPool::ThreadPool(int scheduler, int priority, unsigned threads, unsigned cpu_affinity, const std::string& name)
+        : work_sem(0), next_worker(0), mcpu_affinity(cpu_affinity)
+    {
+        if ( threads == 0 ) {
+#ifdef _SC_NPROCESSORS_ONLN
+            long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+            threads = cpus > 0 ? cpus : 1;
+#else
+            threads = 1;
+#endif
+        }
+        os::CheckPriority(scheduler, priority);
+        workers.reserve(threads);
+        for (unsigned int i = 0; i != threads; ++i) {
+            stringstream wname;
+            wname << name << i;
+            workers.push_back( new Worker(this, i, scheduler, priority, cpu_affinity, wname.str()) );
+        }
+        // only start when all queues exist, since workers steal from each other.
+        for (unsigned int i = 0; i != threads; ++i)
+            workers[i]->start();
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        for (unsigned int i = 0; i != workers.size(); ++i) {
+            workers[i]->quit = true;
+            work_sem.signal();
+        }
+        for (unsigned int i = 0; i != workers.size(); ++i)
+            delete workers[i];
+    }
+
+    int ThreadPool::workerIndex() const
+    {
+        for (unsigned int i = 0; i != workers.size(); ++i)
+            if ( workers[i]->isSelf() )
+                return i;
+        return -1;
+    }
+
+    bool ThreadPool::schedule( PoolActivity* a )
+    {
+        unsigned int n = workers.size();
+        // a worker keeps its own triggers, others are spread out.
+        int self = workerIndex();
+        unsigned int first = self >= 0 ? self : next_worker++ % n;
+        for (unsigned int i = 0; i != n; ++i) {
+            if ( workers[ (first + i) % n ]->queue.enqueue( a ) ) {
+                work_sem.signal();
+                return true;
+            }
+        }
+        log(Error) << "ThreadPool: all worker queues are full, dropped trigger." << endlog();
+        return false;
+    }
+
+    bool ThreadPool::take(unsigned int id, PoolActivity*& a)
+    {
+        unsigned int n = workers.size();
+        // own queue first, then steal from the others.
+        for (unsigned int i = 0; i != n; ++i)
+            if ( workers[ (id + i) % n ]->queue.dequeue( a ) )
+                return true;
+        return false;
+    }
+
+    bool ThreadPool::help()
+    {
+        int self = workerIndex();
+        PoolActivity* a = 0;
+        if ( self < 0 || !take(self, a) )
+            return false;
+        a->work( workers[self] );
+        return true;
+    }
+
+    unsigned int ThreadPool::getWorkerCount() const
+    {
+        return workers.size();
+    }
+
+    os::ThreadInterface* ThreadPool::getWorker(unsigned int i) const
+    {
+        if ( i >= workers.size() )
+            return 0;
+        return workers[i];
+    }
+
+    os::ThreadInterface* ThreadPool::currentWorker() const
+    {
+        int self = workerIndex();
+        return self < 0 ? 0 : workers[self];
+    }
+
+    bool ThreadPool::setScheduler(int scheduler)
+    {
+        bool result = true;
+        for (unsigned int i = 0; i != workers.size(); ++i)
+            result = workers[i]->setScheduler(scheduler) && result;
+        return result;
+    }
+
+    int ThreadPool::getScheduler() const
+    {
+        return workers.front()->getScheduler();
+    }
+
+    bool ThreadPool::setPriority(int priority)
+    {
+        bool result = true;
+        for (unsigned int i = 0; i != workers.size(); ++i)
+            result = workers[i]->setPriority(priority) && result;
+        return result;
+    }
+
+    int ThreadPool::getPriority() const
+    {
+        return workers.front()->getPriority();
+    }
+
+    bool ThreadPool::setCpuAffinity(unsigned cpu_affinity)
+    {
+        bool result = true;
+        mcpu_affinity = cpu_affinity;
+        for (unsigned int i = 0; i != workers.size(); ++i)
+            result = workers[i]->setCpuAffinity(cpu_affinity) && result;
+        return result;
+    }
+
+    unsigned ThreadPool::getCpuAffinity() const
+    {
+        return workers.front()->getCpuAffinity();
+    }
+}
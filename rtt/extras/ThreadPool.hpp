@@ -0,0 +1,186 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  ThreadPool.hpp
+
+                        ThreadPool.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_THREADPOOL_HPP
+#define ORO_THREADPOOL_HPP
+
+#include <vector>
+#include <string>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include "../os/Semaphore.hpp"
+#include "../os/rtt-os-fwd.hpp"
+#include "rtt-extras-fwd.hpp"
+
+namespace RTT
+{ namespace extras {
+
+    /**
+     * ThreadPool objects are reference counted such that
+     * when the last PoolActivity which uses it is deleted,
+     * the worker threads are deleted as well.
+     */
+    typedef boost::shared_ptr<ThreadPool> ThreadPoolPtr;
+
+    /**
+     * A fixed set of non periodic worker threads which execute
+     * the step() of triggered PoolActivity objects.
+     *
+     * Each worker owns a lock-free queue of triggered activities.
+     * A trigger coming from a worker is queued on that worker's own
+     * queue, other triggers are distributed round-robin. An idle
+     * worker first empties its own queue and then steals work from
+     * the queues of the other workers. All workers of a pool share
+     * the same scheduler, priority and CPU affinity.
+     *
+     * @note A worker blocks as long as the step() it executes blocks.
+     * Components which synchronously call each other's operations
+     * should not depend on more workers than the pool has.
+     *
+     * @see PoolActivity
+     */
+    class RTT_API ThreadPool
+    {
+    public:
+        /**
+         * The number of triggered activities each worker can queue.
+         */
+        static const unsigned int MAX_ACTIVITIES = 256;
+
+        /**
+         * Create a pool of worker threads.
+         *
+         * @param scheduler
+         *        The scheduler in which the workers run
+         * @param priority
+         *        The priority of the workers within \a scheduler
+         * @param threads
+         *        The number of workers. Use zero to create one worker
+         *        per online CPU.
+         * @param cpu_affinity
+         *        The CPU affinity mask of the workers.
+         * @param name
+         *        The name prefix of the worker threads.
+         */
+        ThreadPool(int scheduler, int priority, unsigned threads = 0,
+                   unsigned cpu_affinity = ~0, const std::string& name = "ThreadPool");
+
+        /**
+         * Stops and deletes all workers.
+         */
+        ~ThreadPool();
+
+        /**
+         * Returns the shared pool with one worker per CPU for
+         * a given scheduler, priority and CPU affinity.
+         */
+        static ThreadPoolPtr Instance(int scheduler, int priority, unsigned cpu_affinity = ~0);
+
+        /**
+         * Queue a triggered activity for execution by one of the workers.
+         * @return false if all worker queues are full.
+         */
+        bool schedule( PoolActivity* a );
+
+        /**
+         * When called from a worker of this pool, execute one
+         * queued activity in the calling thread.
+         * @return true if an activity was executed.
+         */
+        bool help();
+
+        /**
+         * Returns the number of worker threads.
+         */
+        unsigned int getWorkerCount() const;
+
+        /**
+         * Returns worker thread \a i.
+         */
+        os::ThreadInterface* getWorker(unsigned int i) const;
+
+        /**
+         * Returns the worker thread of this pool which calls
+         * this function, or null if the caller is not a worker.
+         */
+        os::ThreadInterface* currentWorker() const;
+
+        bool setScheduler(int scheduler);
+        int getScheduler() const;
+        bool setPriority(int priority);
+        int getPriority() const;
+        bool setCpuAffinity(unsigned cpu_affinity);
+        unsigned getCpuAffinity() const;
+
+    private:
+        ThreadPool(const ThreadPool&);
+        class Worker;
+        friend class Worker;
+
+        int workerIndex() const;
+        bool take(unsigned int id, PoolActivity*& a);
+
+        std::vector<Worker*> workers;
+        os::Semaphore work_sem;
+        /**
+         * Round-robin start point for triggers from non-worker threads.
+         * Races on this counter only affect the load balancing.
+         */
+        unsigned int volatile next_worker;
+        /**
+         * The CPU affinity as requested by the user, which is used
+         * to find a shared pool in Instance().
+         */
+        unsigned int mcpu_affinity;
+
+        /**
+         * A Boost weak pointer is used to store non-owning pointers
+         * to shared objects.
+         */
+        typedef std::vector< boost::weak_ptr<ThreadPool> > ThreadPoolList;
+
+        /**
+         * All shared pools.
+         */
+        static ThreadPoolList ThreadPools;
+    };
+}}
+
+#endif
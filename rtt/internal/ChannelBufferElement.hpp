@@ -41,6 +41,8 @@
 
 #include "../base/ChannelElement.hpp"
 #include "../base/BufferInterface.hpp"
+#include "ConnectionCounters.hpp"
+#include <algorithm>
 
 namespace RTT { namespace internal {
 
@@ -51,13 +53,16 @@ namespace RTT { namespace internal {
     {
         typename base::BufferInterface<T>::shared_ptr buffer;
         typename base::ChannelElement<T>::value_t *last_sample_p;
+        typedef typename base::BufferInterface<T>::size_type size_type;
+        const size_type capacity;
+        ConnectionCounters counters;
     public:
         typedef typename base::ChannelElement<T>::param_t param_t;
         typedef typename base::ChannelElement<T>::reference_t reference_t;
 	typedef typename base::ChannelElement<T>::value_t value_t;
 
         ChannelBufferElement(typename base::BufferInterface<T>::shared_ptr buffer)
-            : buffer(buffer), last_sample_p(0) {}
+            : buffer(buffer), last_sample_p(0), capacity(buffer->capacity()) {}
             
 	virtual ~ChannelBufferElement()
 	{
@@ -71,7 +76,28 @@ namespace RTT { namespace internal {
          */
         virtual bool write(param_t sample)
         {
-            if (buffer->Push(sample))
+            // a buffer that accepts a sample when it is full is circular:
+            size_type fill = buffer->size();
+            if (buffer->Push(sample)) {
+                counters.written(1, 0, fill >= capacity, fill >= capacity ? capacity : fill + 1);
+                return this->signal();
+            }
+            counters.written(1, 1, 0, fill);
+            return true;
+        }
+
+        /** Appends the samples at the end of the FIFO and signals once.
+         *
+         * @return true, samples for which there was no room are dropped.
+         */
+        virtual bool writeBatch(std::vector<value_t> const& samples)
+        {
+            size_type fill = buffer->size();
+            size_type stored = buffer->Push(samples);
+            size_type count = samples.size();
+            size_type overwritten = (stored == count && fill + count > capacity) ? fill + count - capacity : 0;
+            counters.written(count, count - stored, overwritten, std::min(fill + stored, capacity));
+            if (stored)
                 return this->signal();
             return true;
         }
@@ -89,14 +115,52 @@ namespace RTT { namespace internal {
 		
 		last_sample_p = new_sample_p;
 		sample = *new_sample_p;
-                return NewData;
+                return counters.read(NewData);
             }
             if (last_sample_p) {
 		if(copy_old_data)
 		    sample = *(last_sample_p);
-                return OldData;
+                return counters.read(OldData);
             }
-            return NoData;
+            return counters.read(NoData);
+        }
+
+        /** Pops all elements of the FIFO and appends them to \a samples.
+         * The last one is kept, such that a later read() returns it as OldData.
+         */
+        virtual FlowStatus readAll(std::vector<value_t>& samples)
+        {
+            value_t *new_sample_p;
+            FlowStatus result = last_sample_p ? OldData : NoData;
+            while ( (new_sample_p = buffer->PopWithoutRelease()) ) {
+                if(last_sample_p)
+                    buffer->Release(last_sample_p);
+                last_sample_p = new_sample_p;
+                samples.push_back(*new_sample_p);
+                result = NewData;
+            }
+            return counters.read(result);
+        }
+
+        /** Pops the first element of the FIFO and keeps it in the buffer
+         * until the next read, such that it does not need to be copied.
+         */
+        virtual FlowStatus readLoaned(value_t const*& sample)
+        {
+	    value_t *new_sample_p;
+            if ( (new_sample_p = buffer->PopWithoutRelease()) ) {
+		if(last_sample_p)
+		    buffer->Release(last_sample_p);
+
+		last_sample_p = new_sample_p;
+		sample = new_sample_p;
+                return counters.read(NewData);
+            }
+            if (last_sample_p) {
+		sample = last_sample_p;
+                return counters.read(OldData);
+            }
+            return counters.read(NoData);
         }
 
         /** Removes all elements in the FIFO. After a call to clear(), read()
@@ -122,6 +186,17 @@ namespace RTT { namespace internal {
         {
             return buffer->data_sample();
         }
+
+        virtual bool getStatistics(ConnectionStatistics& stats) const
+        {
+            counters.snapshot(stats);
+            return true;
+        }
+
+        virtual void resetStatistics()
+        {
+            counters.reset();
+        }
     };
 }}
 
@@ -41,6 +41,7 @@
 
 #include "../base/ChannelElement.hpp"
 #include "../base/DataObjectInterface.hpp"
+#include "ConnectionCounters.hpp"
 
 namespace RTT { namespace internal {
 
@@ -51,44 +52,76 @@ namespace RTT { namespace internal {
     {
         bool written, mread;
         typename base::DataObjectInterface<T>::shared_ptr data;
+        /** The copy returned by readLoaned() */
+        T loaned_sample;
+        /** True if loaned_sample holds the last read sample */
+        bool loaned;
+        ConnectionCounters counters;
 
     public:
         typedef typename base::ChannelElement<T>::param_t param_t;
         typedef typename base::ChannelElement<T>::reference_t reference_t;
 
         ChannelDataElement(typename base::DataObjectInterface<T>::shared_ptr sample)
-            : written(false), mread(false), data(sample) {}
+            : written(false), mread(false), data(sample), loaned(false) {}
 
         /** Update the data sample stored in this element.
          * It always returns true. */
         virtual bool write(param_t sample)
         {
-            data->Set(sample);
+            bool stored = data->Set(sample);
+            counters.written(1, !stored, stored && written && !mread, 1);
             written = true;
             mread = false;
             return this->signal();
         }
 
+        /** Only the last sample of a batch is kept, so only that one
+         * is written. */
+        virtual bool writeBatch(std::vector<T> const& samples)
+        {
+            if (samples.empty())
+                return true;
+            // all but the last sample are overwritten right away:
+            counters.written(samples.size() - 1, 0, samples.size() - 1, 1);
+            return write(samples.back());
+        }
+
         /** Reads the last sample given to write()
          *
          * @return false if no sample has ever been written, true otherwise
          */
         virtual FlowStatus read(reference_t sample, bool copy_old_data)
         {
+            loaned = false;
             if (written)
             {
                 if ( !mread ) {
 		    data->Get(sample);
                     mread = true;
-                    return NewData;
+                    return counters.read(NewData);
                 }
 
 		if(copy_old_data)
 		    data->Get(sample);
 
-                return OldData;
+                return counters.read(OldData);
             }
-            return NoData;
+            return counters.read(NoData);
+        }
+
+        /** The data object does not allow to keep a sample pinned, so the
+         * sample is copied once into this element and a pointer to the copy
+         * is returned.
+         */
+        virtual FlowStatus readLoaned(typename base::ChannelElement<T>::value_t const*& sample)
+        {
+            // OldData only needs a copy if read() was used in between.
+            FlowStatus result = read(loaned_sample, !loaned);
+            loaned = (result != NoData);
+            if (loaned)
+                sample = &loaned_sample;
+            return result;
         }
 
         /** Resets the stored sample. After clear() has been called, read()
@@ -98,6 +131,7 @@ namespace RTT { namespace internal {
         {
             written = false;
             mread = false;
+            loaned = false;
             base::ChannelElement<T>::clear();
         }
 
@@ -112,6 +146,17 @@ namespace RTT { namespace internal {
             return data->Get();
         }
 
+        virtual bool getStatistics(ConnectionStatistics& stats) const
+        {
+            counters.snapshot(stats);
+            return true;
+        }
+
+        virtual void resetStatistics()
+        {
+            counters.reset();
+        }
+
     };
 }}
 
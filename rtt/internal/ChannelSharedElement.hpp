@@ -0,0 +1,557 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  ChannelSharedElement.hpp
+
+                        ChannelSharedElement.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_CHANNEL_SHARED_ELEMENT_HPP
+#define ORO_CHANNEL_SHARED_ELEMENT_HPP
+
+#include "../base/ChannelElement.hpp"
+#include "../ConnPolicy.hpp"
+#include "../os/oro_arch.h"
+#include "../os/CAS.hpp"
+#include "../os/Mutex.hpp"
+#include "../os/MutexLock.hpp"
+#include "ConnectionCounters.hpp"
+#include <boost/shared_ptr.hpp>
+#include <boost/call_traits.hpp>
+
+namespace RTT { namespace internal {
+
+    /**
+     * A lock-free storage which is shared by all the local connections of
+     * one OutputPort that were created with ConnPolicy::shared set.
+     *
+     * A sample is copied only once into the storage, and each reader keeps
+     * its own read cursor, such that every reader gets the NewData/OldData
+     * semantics it would get on a private connection of the same policy.
+     * The storage has a single writer (the output port) and up to
+     * MAX_READERS readers.
+     *
+     * The policy type dictates what happens when the storage is full:
+     * <ul>
+     *  <li>DATA: only the last sample is kept.
+     *  <li>CIRCULAR_BUFFER: readers that fall more than \a size samples behind
+     *      lose the oldest samples.
+     *  <li>BUFFER: new samples are dropped as long as the slowest reader has
+     *      \a size unread samples.
+     * </ul>
+     *
+     * Samples are numbered from 1 on. The last \a size samples are 'live'
+     * and are never overwritten. Readers pin the slot they are copying from
+     * and keep the slot of their last read sample pinned for OldData reads.
+     * Hence the storage needs \a size + 1 + 2 * readers slots, which are
+     * allocated when a reader registers.
+     * @ingroup PortBuffers
+     */
+    template<typename T>
+    class ChannelSharedStorage
+    {
+    public:
+        typedef boost::shared_ptr< ChannelSharedStorage<T> > shared_ptr;
+        typedef typename boost::call_traits<T>::param_type param_t;
+        typedef typename boost::call_traits<T>::reference reference_t;
+        typedef unsigned long Sequence;
+
+        /**
+         * The maximum number of readers that can share one storage.
+         */
+        static const unsigned int MAX_READERS = 32;
+
+    private:
+        struct Slot {
+            Slot(param_t sample) : data(sample), seq(0) { oro_atomic_set(&pins, 0); }
+            T data;
+            /** The number of the sample in data, zero if none. */
+            Sequence volatile seq;
+            mutable oro_atomic_t pins;
+        };
+
+        struct Reader {
+            Reader() : used(false), next(0), last(0) {}
+            bool volatile used;
+            /** The number of the next sample this reader wants to read. */
+            Sequence volatile next;
+            /** The pinned slot of the last sample read, zero if none. */
+            Slot* last;
+        };
+
+        const int mtype;
+        const unsigned int mcapacity;
+        const unsigned int max_slots;
+
+        /** The number of the last published sample. */
+        Sequence volatile head;
+        /** Maps the live sample numbers to their slot. */
+        Slot* volatile* index;
+        Slot** slots;
+        unsigned int volatile nslots;
+        unsigned int next_free;
+
+        Reader readers[MAX_READERS];
+        unsigned int nreaders;
+
+        /** Used by write() to only copy a sample once per OutputPort::write() */
+        unsigned int write_generation;
+        bool write_result;
+        /** Set while a thread is writing, the storage allows only one writer at a time. */
+        int volatile writing;
+        /** The slot returned by loan() */
+        Slot* loaned_slot;
+
+        /** Serializes the (un)registration of readers and the access to sample. */
+        mutable os::Mutex reader_lock;
+        T sample;
+
+        bool isLive(Sequence seq, Sequence current) const {
+            return seq != 0 && current - seq < mcapacity;
+        }
+
+        bool doWrite(param_t push) {
+            Slot* slot = freeSlot();
+            if (!slot)
+                return false;
+            slot->data = push;
+            publish(slot);
+            return true;
+        }
+
+        /**
+         * Returns a slot the writer may fill, or null if the sample must
+         * be dropped.
+         */
+        Slot* freeSlot() {
+            Sequence current = head;
+            if (mtype == ConnPolicy::BUFFER) {
+                for (unsigned int id = 0; id != MAX_READERS; ++id)
+                    if ( readers[id].used && current + 1 - readers[id].next >= mcapacity )
+                        return 0;
+            }
+            Slot* slot = findFreeSlot(current);
+            if (slot)
+                slot->seq = 0;
+            return slot;
+        }
+
+        /**
+         * Publishes a filled slot as the next sample.
+         */
+        void publish(Slot* slot) {
+            Sequence current = head;
+            slot->seq = current + 1;
+            index[ current % mcapacity ] = slot;
+            // this is a full memory barrier.
+            os::CAS(&head, current, current + 1);
+        }
+
+        /**
+         * Pins the next sample to read as r.last.
+         */
+        FlowStatus advance(Reader& r) {
+            Sequence current;
+            while ( r.next != (current = head) + 1 ) {
+                // skip the samples that are no longer live.
+                Sequence seq = current + 1 - r.next > mcapacity ? current + 1 - mcapacity : r.next;
+                Slot* slot = index[ (seq - 1) % mcapacity ];
+                oro_atomic_inc(&slot->pins);
+                if ( slot->seq != seq || !isLive(seq, head) ) {
+                    // overwritten in the meantime, start over.
+                    oro_atomic_dec(&slot->pins);
+                    continue;
+                }
+                if (r.last)
+                    oro_atomic_dec(&r.last->pins);
+                r.last = slot;
+                r.next = seq + 1;
+                return NewData;
+            }
+            return r.last ? OldData : NoData;
+        }
+
+        Slot* findFreeSlot(Sequence current) {
+            unsigned int n = nslots;
+            for (unsigned int i = 0; i != n; ++i) {
+                Slot* slot = slots[ (next_free + i) % n ];
+                if ( oro_atomic_read(&slot->pins) == 0 && !isLive(slot->seq, current) ) {
+                    next_free = (next_free + i + 1) % n;
+                    return slot;
+                }
+            }
+            return 0;
+        }
+
+        void addSlot() {
+            slots[nslots] = new Slot(sample);
+            // publish the new slot to the writer.
+            unsigned int n = nslots;
+            os::CAS(&nslots, n, n + 1);
+        }
+
+        ChannelSharedStorage(ChannelSharedStorage const&);
+        ChannelSharedStorage& operator=(ChannelSharedStorage const&);
+    public:
+        /**
+         * Creates a shared storage.
+         * @param policy Only the type and size fields are used.
+         * @param initial_value The sample used to initialize the slots.
+         */
+        ChannelSharedStorage(ConnPolicy const& policy, param_t initial_value = T())
+            : mtype(policy.type),
+              mcapacity( policy.type == ConnPolicy::DATA || policy.size < 1 ? 1 : policy.size ),
+              max_slots( mcapacity + 1 + 2 * MAX_READERS ),
+              head(0), index(0), slots(0), nslots(0), next_free(0),
+              nreaders(0), write_generation(0), write_result(false), writing(0), loaned_slot(0),
+              sample(initial_value)
+        {
+            index = new Slot* volatile[mcapacity];
+            for (unsigned int i = 0; i != mcapacity; ++i)
+                index[i] = 0;
+            slots = new Slot*[max_slots];
+            for (unsigned int i = 0; i != mcapacity + 1; ++i)
+                addSlot();
+        }
+
+        ~ChannelSharedStorage() {
+            for (unsigned int i = 0; i != nslots; ++i)
+                delete slots[i];
+            delete[] slots;
+            delete[] index;
+        }
+
+        /**
+         * Returns true if this storage was created for connections
+         * with \a policy.
+         */
+        bool isCompatible(ConnPolicy const& policy) const {
+            if (policy.type != mtype)
+                return false;
+            return mtype == ConnPolicy::DATA || (unsigned int)policy.size == mcapacity;
+        }
+
+        /**
+         * Registers a new reader. This allocates memory and may not be
+         * called from a real-time thread.
+         * @param init If true and a sample was written, the reader will
+         * read the last written sample as NewData.
+         * @return the reader id or -1 if MAX_READERS was reached.
+         */
+        int registerReader(bool init) {
+            os::MutexLock lock(reader_lock);
+            for (unsigned int id = 0; id != MAX_READERS; ++id) {
+                Reader& r = readers[id];
+                if (r.used)
+                    continue;
+                // two pins per reader.
+                while ( nslots < mcapacity + 1 + 2 * (nreaders + 1) )
+                    addSlot();
+                ++nreaders;
+                Sequence current = head;
+                r.last = 0;
+                r.next = (init && current != 0) ? current : current + 1;
+                // only now the writer may take this reader into account.
+                r.used = true;
+                return id;
+            }
+            return -1;
+        }
+
+        /**
+         * Unregisters a reader and releases its pinned sample.
+         */
+        void unregisterReader(int id) {
+            os::MutexLock lock(reader_lock);
+            Reader& r = readers[id];
+            if (r.last)
+                oro_atomic_dec(&r.last->pins);
+            r.last = 0;
+            r.used = false;
+            --nreaders;
+        }
+
+        /**
+         * Writes a new sample into the storage.
+         * @return false if the sample was dropped because the storage is
+         * full (BUFFER), because too many readers are reading concurrently
+         * or because another thread is writing concurrently.
+         */
+        bool write(param_t push) {
+            if ( !os::CAS(&writing, 0, 1) )
+                return false;
+            bool result = doWrite(push);
+            writing = 0;
+            return result;
+        }
+
+        /**
+         * Writes \a push only if it was not yet written for \a generation.
+         * This allows every connection of an OutputPort to call this function
+         * during one write while the sample is only copied once.
+         * @return the result of write() for this generation.
+         */
+        bool write(param_t push, unsigned int generation) {
+            if ( !os::CAS(&writing, 0, 1) )
+                return false;
+            if (generation != write_generation) {
+                write_result = doWrite(push);
+                write_generation = generation;
+            }
+            bool result = write_result;
+            writing = 0;
+            return result;
+        }
+
+        /**
+         * Writes all \a samples only if they were not yet written for
+         * \a generation, which identifies the whole batch.
+         * @return true if at least one sample of the batch was written.
+         */
+        bool writeBatch(std::vector<T> const& samples, unsigned int generation) {
+            if ( !os::CAS(&writing, 0, 1) )
+                return false;
+            if (generation != write_generation) {
+                write_result = false;
+                for (typename std::vector<T>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+                    write_result = doWrite(*it) || write_result;
+                write_generation = generation;
+            }
+            bool result = write_result;
+            writing = 0;
+            return result;
+        }
+
+        /**
+         * Reads the next sample for reader \a id.
+         */
+        FlowStatus read(int id, reference_t pull, bool copy_old_data) {
+            Reader& r = readers[id];
+            FlowStatus result = advance(r);
+            if ( result == NewData || (result == OldData && copy_old_data) )
+                pull = r.last->data;
+            return result;
+        }
+
+        /**
+         * Reads the next sample for reader \a id without copying it.
+         * The sample remains valid until the next read of this reader.
+         */
+        FlowStatus readLoaned(int id, T const*& pull) {
+            Reader& r = readers[id];
+            FlowStatus result = advance(r);
+            if (result != NoData)
+                pull = &r.last->data;
+            return result;
+        }
+
+        /**
+         * Borrows a free slot, which the caller fills in place and publishes
+         * with commit(). Until then, all other writes are dropped.
+         * @return null if no slot is available, for example because a
+         * BUFFER is full.
+         */
+        T* loan() {
+            if ( !os::CAS(&writing, 0, 1) )
+                return 0;
+            Slot* slot = freeSlot();
+            if (!slot) {
+                writing = 0;
+                return 0;
+            }
+            loaned_slot = slot;
+            return &slot->data;
+        }
+
+        /**
+         * Publishes the sample returned by loan(), which counts as the write of
+         * \a generation.
+         */
+        void commit(unsigned int generation) {
+            publish(loaned_slot);
+            loaned_slot = 0;
+            write_generation = generation;
+            write_result = true;
+            writing = 0;
+        }
+
+        /**
+         * Discards all samples for reader \a id, such that it returns NoData
+         * until a new sample is written.
+         */
+        void clear(int id) {
+            Reader& r = readers[id];
+            if (r.last)
+                oro_atomic_dec(&r.last->pins);
+            r.last = 0;
+            r.next = head + 1;
+        }
+
+        /**
+         * Provides a sample which is used to initialize the slots that are
+         * allocated when readers register. The slots that already exist
+         * are owned by the writer and are not modified.
+         */
+        void data_sample(param_t push) {
+            os::MutexLock lock(reader_lock);
+            sample = push;
+        }
+
+        T data_sample() const {
+            os::MutexLock lock(reader_lock);
+            return sample;
+        }
+    };
+
+    /**
+     * A connection element that reads from a ChannelSharedStorage, which it
+     * shares with the other connections of the same OutputPort.
+     */
+    template<typename T>
+    class ChannelSharedElement : public base::ChannelElement<T>
+    {
+        typename ChannelSharedStorage<T>::shared_ptr storage;
+        int reader;
+        /** Only counts writes, drops and reads, the fill level of the
+         * storage is shared with the other connections. */
+        ConnectionCounters counters;
+
+        bool written(bool stored, unsigned int count = 1) {
+            counters.written(count, stored ? 0 : count, 0, 0);
+            if (stored)
+                return this->signal();
+            return true;
+        }
+
+    public:
+        typedef typename base::ChannelElement<T>::param_t param_t;
+        typedef typename base::ChannelElement<T>::reference_t reference_t;
+
+        /**
+         * Creates a new reader of \a storage.
+         * @param init If the last written sample must be read as NewData.
+         * @see isRegistered()
+         */
+        ChannelSharedElement(typename ChannelSharedStorage<T>::shared_ptr storage, bool init)
+            : storage(storage), reader( storage->registerReader(init) ) {}
+
+        ~ChannelSharedElement()
+        {
+            if (reader != -1)
+                storage->unregisterReader(reader);
+        }
+
+        /**
+         * Returns false if the storage had no room for a new reader, in which
+         * case this element may not be used.
+         */
+        bool isRegistered() const { return reader != -1; }
+
+        typename ChannelSharedStorage<T>::shared_ptr getStorage() const { return storage; }
+
+        /** Writes a sample in the shared storage. All readers of the storage
+         * will see it, but only this connection is signalled.
+         */
+        virtual bool write(param_t sample)
+        {
+            return written( storage->write(sample) );
+        }
+
+        /** Writes a sample in the shared storage if this was not yet done for
+         * \a generation and signals this connection.
+         */
+        bool write(param_t sample, unsigned int generation)
+        {
+            return written( storage->write(sample, generation) );
+        }
+
+        /** Writes all \a samples in the shared storage and signals this
+         * connection once.
+         */
+        virtual bool writeBatch(std::vector<T> const& samples)
+        {
+            bool stored = false;
+            for (typename std::vector<T>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+                stored = storage->write(*it) || stored;
+            return written( stored, samples.size() );
+        }
+
+        /** Writes the samples of a batch in the shared storage if this was
+         * not yet done for \a generation and signals this connection once.
+         */
+        bool writeBatch(std::vector<T> const& samples, unsigned int generation)
+        {
+            return written( storage->writeBatch(samples, generation), samples.size() );
+        }
+
+        virtual FlowStatus read(reference_t sample, bool copy_old_data)
+        {
+            return counters.read( storage->read(reader, sample, copy_old_data) );
+        }
+
+        virtual FlowStatus readLoaned(typename base::ChannelElement<T>::value_t const*& sample)
+        {
+            return counters.read( storage->readLoaned(reader, sample) );
+        }
+
+        virtual void clear()
+        {
+            storage->clear(reader);
+            base::ChannelElement<T>::clear();
+        }
+
+        virtual bool data_sample(param_t sample)
+        {
+            storage->data_sample(sample);
+            return base::ChannelElement<T>::data_sample(sample);
+        }
+
+        virtual T data_sample()
+        {
+            return storage->data_sample();
+        }
+
+        virtual bool getStatistics(ConnectionStatistics& stats) const
+        {
+            counters.snapshot(stats);
+            return true;
+        }
+
+        virtual void resetStatistics()
+        {
+            counters.reset();
+        }
+    };
+}}
+
+#endif
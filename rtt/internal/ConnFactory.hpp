@@ -50,13 +50,40 @@
 
 #include "../base/DataObject.hpp"
 #include "../base/DataObjectUnSync.hpp"
+#ifndef OROBLD_OS_NO_ASM
+#include "../base/DataObjectSeqLock.hpp"
+#endif
 #include "../base/Buffer.hpp"
 #include "../base/BufferUnSync.hpp"
 #include "../Logger.hpp"
+#include <boost/utility/enable_if.hpp>
 
 namespace RTT
 { namespace internal {
 
+#ifndef OROBLD_OS_NO_ASM
+    /**
+     * Selects the lock-free data object for type \a T:
+     * a DataObjectSeqLock for the types that allow it
+     * and a DataObjectLockFree for all others.
+     */
+    template<class T, class Enable = void>
+    struct LockFreeDataObject
+    {
+        static base::DataObjectInterface<T>* create(const T& initial_value) {
+            return new base::DataObjectLockFree<T>(initial_value);
+        }
+    };
+
+    template<class T>
+    struct LockFreeDataObject<T, typename boost::enable_if< base::is_seqlock_copyable<T> >::type>
+    {
+        static base::DataObjectInterface<T>* create(const T& initial_value) {
+            return new base::DataObjectSeqLock<T>(initial_value);
+        }
+    };
+#endif
+
     /**
      * Represents a local connection created by the ConnFactory.
      */
@@ -145,7 +172,7 @@ namespace RTT
                 {
 #ifndef OROBLD_OS_NO_ASM
                 case ConnPolicy::LOCK_FREE:
-                    data_object.reset( new base::DataObjectLockFree<T>(initial_value) );
+                    data_object.reset( LockFreeDataObject<T>::create(initial_value) );
                     break;
 #else
 		case ConnPolicy::LOCK_FREE:
@@ -261,6 +288,41 @@ namespace RTT
             return data_object;
         }
 
+        /**
+         * Variant of buildBufferedChannelOutput for ConnPolicy::shared connections.
+         * The returned element reads from the storage that is shared by the
+         * shared connections of \a output_port with the same type and size,
+         * or from a new storage if there is none yet.
+         * @return null if the storage can not accept another reader.
+         */
+        template<typename T>
+        static base::ChannelElementBase::shared_ptr buildSharedChannelOutput(OutputPort<T>& output_port, InputPort<T>& port, ConnID* conn_id, ConnPolicy const& policy)
+        {
+            assert(conn_id);
+            typename ChannelSharedStorage<T>::shared_ptr storage;
+            std::list<ConnectionManager::ChannelDescriptor> channels = output_port.getManager()->getChannels();
+            for (std::list<ConnectionManager::ChannelDescriptor>::iterator it = channels.begin(); it != channels.end() && !storage; ++it) {
+                if ( !it->get<2>().shared )
+                    continue;
+                ChannelSharedElement<T>* shared = dynamic_cast< ChannelSharedElement<T>* >( it->get<1>()->getOutput().get() );
+                if ( shared && shared->getStorage()->isCompatible(policy) )
+                    storage = shared->getStorage();
+            }
+            if (!storage) {
+                storage.reset( new ChannelSharedStorage<T>(policy, output_port.getLastWrittenValue()) );
+                T initial_sample;
+                if ( policy.init && output_port.getLastWrittenValue(initial_sample) )
+                    storage->write(initial_sample);
+            }
+            ChannelSharedElement<T>* shared = new ChannelSharedElement<T>(storage, policy.init);
+            base::ChannelElementBase::shared_ptr data_object = shared;
+            if ( !shared->isRegistered() )
+                return 0;
+            base::ChannelElementBase::shared_ptr endpoint = new ConnOutputEndpoint<T>(&port, conn_id);
+            data_object->setOutput(endpoint);
+            return data_object;
+        }
+
         /**
          * Creates a connection from a local output_port to a local or remote input_port.
          * This function contains all logic to decide on how connections must be created to
@@ -280,6 +342,10 @@ namespace RTT
 
             InputPort<T>* input_p = dynamic_cast<InputPort<T>*>(&input_port);
 
+            // Only local connections can share their storage.
+            ConnPolicy local_policy = policy;
+            local_policy.shared = false;
+
             // This is the input channel element of the output half
             base::ChannelElementBase::shared_ptr output_half = 0;
             if (input_port.isLocal() && policy.transport == 0)
@@ -290,8 +356,18 @@ namespace RTT
                     log(Error) << "Port " << input_port.getName() << " is not compatible with " << output_port.getName() << endlog();
                     return false;
                 }
+                ConnID* conn_id = output_port.getPortID();
+                if (policy.shared)
+                {
+                    output_half = buildSharedChannelOutput<T>(output_port, *input_p, conn_id, policy);
+                    if (output_half)
+                        local_policy.shared = true;
+                    else
+                        log(Warning) << "Too many shared connections on port " << output_port.getName() << ", creating a private connection to " << input_port.getName() << endlog();
+                }
                 // local ports, create buffer here.
-                output_half = buildBufferedChannelOutput<T>(*input_p, output_port.getPortID(), policy, output_port.getLastWrittenValue());
+                if (!output_half)
+                    output_half = buildBufferedChannelOutput<T>(*input_p, conn_id, policy, output_port.getLastWrittenValue());
             }
             else
             {
@@ -313,7 +389,7 @@ namespace RTT
             base::ChannelElementBase::shared_ptr channel_input =
                 buildChannelInput<T>(output_port, input_port.getPortID(), output_half);
 
-            return createAndCheckConnection(output_port, input_port, channel_input, policy );
+            return createAndCheckConnection(output_port, input_port, channel_input, local_policy );
         }
 
         /**
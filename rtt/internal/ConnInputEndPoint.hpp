@@ -75,6 +75,15 @@ namespace RTT
             return true;
         }
 
+        /** Passes the batch as a whole to the next element. */
+        virtual bool writeBatch(std::vector<T> const& samples)
+        {
+            base::ChannelElement<T>* output = this->currentOutput();
+            if (output)
+                return output->writeBatch(samples);
+            return false;
+        }
+
         virtual void disconnect(bool forward)
         {
             // Call the base class first
@@ -97,6 +97,15 @@ namespace RTT
         virtual bool write(typename base::ChannelElement<T>::param_t sample)
         { return false; }
 
+        /** Drains the storage element of this connection as a whole. */
+        virtual FlowStatus readAll(std::vector<T>& samples)
+        {
+            base::ChannelElement<T>* input = this->currentInput();
+            if (input)
+                return input->readAll(samples);
+            return NoData;
+        }
+
         virtual void disconnect(bool forward)
         {
             // Call the base class: it does the common cleanup
@@ -0,0 +1,130 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  ConnectionCounters.hpp
+
+                        ConnectionCounters.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_CONNECTION_COUNTERS_HPP
+#define ORO_CONNECTION_COUNTERS_HPP
+
+#include "../ConnectionStatistics.hpp"
+#include "../FlowStatus.hpp"
+#include "../os/TimeService.hpp"
+
+namespace RTT
+{ namespace internal {
+
+    /**
+     * The counters from which a ConnectionStatistics snapshot is made.
+     * They are kept by the data storage elements of a connection.
+     *
+     * The write counters are only modified by the writer and the read
+     * counters only by the reader of the connection, so no atomic
+     * operations are needed. A snapshot taken by a third thread may be
+     * slightly out of date, but never blocks the data path.
+     */
+    class ConnectionCounters
+    {
+        unsigned int volatile writes, drops, overwrites, high_water_mark;
+        unsigned int volatile new_data, old_data, no_data;
+        os::TimeService::ticks volatile last_write, last_read;
+
+        static os::TimeService::ticks now() {
+            return os::TimeService::Instance()->getTicks();
+        }
+
+    public:
+        ConnectionCounters() { reset(); }
+
+        /**
+         * Counts the write of \a count samples.
+         * @param dropped the number of samples that were not stored.
+         * @param overwritten the number of unread samples that were lost to make room.
+         * @param fill the number of stored samples after the write.
+         */
+        void written(unsigned int count, unsigned int dropped, unsigned int overwritten, unsigned int fill) {
+            writes = writes + count;
+            if (dropped)
+                drops = drops + dropped;
+            if (overwritten)
+                overwrites = overwrites + overwritten;
+            if (fill > high_water_mark)
+                high_water_mark = fill;
+            last_write = now();
+        }
+
+        /**
+         * Counts a read which returned \a status.
+         */
+        FlowStatus read(FlowStatus status) {
+            if (status == NewData)
+                new_data = new_data + 1;
+            else if (status == OldData)
+                old_data = old_data + 1;
+            else
+                no_data = no_data + 1;
+            last_read = now();
+            return status;
+        }
+
+        /**
+         * Fills in the counters of \a stats.
+         */
+        void snapshot(ConnectionStatistics& stats) const {
+            stats.writes = writes;
+            stats.drops = drops;
+            stats.overwrites = overwrites;
+            stats.high_water_mark = high_water_mark;
+            stats.new_data = new_data;
+            stats.old_data = old_data;
+            stats.no_data = no_data;
+            stats.reads = stats.new_data + stats.old_data + stats.no_data;
+            stats.last_write = last_write ? os::TimeService::ticks2nsecs(last_write) / 1e9 : 0.0;
+            stats.last_read = last_read ? os::TimeService::ticks2nsecs(last_read) / 1e9 : 0.0;
+        }
+
+        /**
+         * Clears all counters.
+         */
+        void reset() {
+            writes = drops = overwrites = high_water_mark = 0;
+            new_data = old_data = no_data = 0;
+            last_write = last_read = 0;
+        }
+    };
+}}
+
+#endif
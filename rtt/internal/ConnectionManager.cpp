@@ -48,6 +48,8 @@
 #include <boost/scoped_ptr.hpp>
 #include "../base/PortInterface.hpp"
 #include "../os/MutexLock.hpp"
+#include "../os/CAS.hpp"
+#include "../os/fosi.h"
 #include "../base/InputPortInterface.hpp"
 #include <cassert>
 
@@ -59,26 +61,70 @@ namespace RTT
     {
 
         ConnectionManager::ConnectionManager(PortInterface* port)
-            : mport(port)
+            : mport(port), table( new ConnectionTable() ), has_removed_connections(false)
         {
         }
 
         ConnectionManager::~ConnectionManager()
         {
             this->disconnect();
+            delete table;
         }
 
-        /**
-         * Helper function to clear a connection.
-         * @param descriptor
-         */
-        void clearChannel(ConnectionManager::ChannelDescriptor& descriptor) {
-            descriptor.get<1>()->clear();
+        void ConnectionManager::clear()
+        {
+            ConnectionTable* t = acquireTable();
+            for (Connection* it = t->begin(); it != t->end(); ++it)
+                if ( !it->removed )
+                    it->descriptor.get<1>()->clear();
+            releaseTable(t);
         }
 
-        void ConnectionManager::clear()
-        { RTT::os::MutexLock lock(connection_lock);
-            std::for_each(connections.begin(), connections.end(), &clearChannel);
+        namespace {
+            /**
+             * Returns the element of the connection of \a channel which
+             * keeps its statistics, or null if it is not in this process.
+             */
+            ChannelElementBase* findStatistics(ChannelElementBase* channel, ConnectionStatistics& stats)
+            {
+                // an output port holds the start of the connection,
+                // an input port its end.
+                for (ChannelElementBase* e = channel; e; e = e->currentOutput())
+                    if ( e->getStatistics(stats) )
+                        return e;
+                for (ChannelElementBase* e = channel->currentInput(); e; e = e->currentInput())
+                    if ( e->getStatistics(stats) )
+                        return e;
+                return 0;
+            }
+        }
+
+        std::vector<ConnectionStatistics> ConnectionManager::getStatistics() const
+        {
+            std::vector<ConnectionStatistics> result;
+            ConnectionTable* t = acquireTable();
+            for (Connection* it = t->begin(); it != t->end(); ++it) {
+                ConnectionStatistics stats;
+                if ( !it->removed && findStatistics( it->descriptor.get<1>().get(), stats ) ) {
+                    stats.port = mport->getName();
+                    stats.policy = it->descriptor.get<2>();
+                    result.push_back( stats );
+                }
+            }
+            releaseTable(t);
+            return result;
+        }
+
+        void ConnectionManager::resetStatistics() const
+        {
+            ConnectionTable* t = acquireTable();
+            for (Connection* it = t->begin(); it != t->end(); ++it) {
+                ConnectionStatistics stats;
+                ChannelElementBase* e = it->removed ? 0 : findStatistics( it->descriptor.get<1>().get(), stats );
+                if ( e )
+                    e->resetStatistics();
+            }
+            releaseTable(t);
         }
 
         bool ConnectionManager::findMatchingPort(ConnID const* conn_id, ChannelDescriptor const& descriptor)
@@ -86,12 +132,43 @@ namespace RTT
             return ( descriptor.get<0>() && conn_id->isSameID(*descriptor.get<0>()));
         }
 
-        void ConnectionManager::updateCurrentChannel(bool reset_current)
+        ConnectionManager::ConnectionTable* ConnectionManager::copyTable() const
         {
-            if (connections.empty())
-                cur_channel = ChannelDescriptor();
-            else if (reset_current)
-                cur_channel = connections.front();
+            ConnectionTable* old_table = table;
+            ConnectionTable* result = new ConnectionTable();
+            result->connections.reserve( old_table->size() + 1 );
+            unsigned int current = old_table->current;
+            for (unsigned int i = 0; i != old_table->size(); ++i) {
+                if ( old_table->at(i).removed )
+                    continue;
+                // the current channel keeps being the current channel.
+                if ( i == current )
+                    result->current = result->size();
+                result->connections.push_back( Connection( old_table->at(i).descriptor ) );
+            }
+            return result;
+        }
+
+        ConnectionManager::ConnectionTable* ConnectionManager::replaceTable(ConnectionTable* new_table)
+        {
+            ConnectionTable* old_table = table;
+            // this is a full memory barrier, such that the readers see a complete table.
+            os::CAS(&table, old_table, new_table);
+            // wait until all threads stopped iterating the old table.
+            while ( oro_atomic_read(&old_table->users) != 0 ) {
+                TIME_SPEC ts = ticks2timespec( nano2ticks(10000) );
+                rtos_nanosleep(&ts, 0);
+            }
+            return old_table;
+        }
+
+        void ConnectionManager::removeInvalidConnections()
+        {
+            RTT::os::MutexLock lock(connection_lock);
+            if ( !has_removed_connections )
+                return;
+            has_removed_connections = false;
+            delete replaceTable( copyTable() );
         }
 
         bool ConnectionManager::disconnect(PortInterface* port)
@@ -115,37 +192,94 @@ namespace RTT
         {
             std::list<ChannelDescriptor> all_connections;
             { RTT::os::MutexLock lock(connection_lock);
-                all_connections.splice(all_connections.end(), connections);
-                cur_channel = ChannelDescriptor();
+                has_removed_connections = false;
+                ConnectionTable* old_table = replaceTable( new ConnectionTable() );
+                for (Connection* it = old_table->begin(); it != old_table->end(); ++it)
+                    if ( !it->removed )
+                        all_connections.push_back( it->descriptor );
+                delete old_table;
             }
             std::for_each(all_connections.begin(), all_connections.end(),
                     boost::bind(&ConnectionManager::eraseConnection, this, _1));
         }
 
         bool ConnectionManager::connected() const
-        { return !connections.empty(); }
+        {
+            ConnectionTable* t = acquireTable();
+            bool result = false;
+            for (Connection* it = t->begin(); it != t->end() && !result; ++it)
+                result = !it->removed;
+            releaseTable(t);
+            return result;
+        }
 
+        bool ConnectionManager::isSingleConnection() const
+        {
+            ConnectionTable* t = acquireTable();
+            unsigned int count = 0;
+            for (Connection* it = t->begin(); it != t->end(); ++it)
+                if ( !it->removed )
+                    ++count;
+            releaseTable(t);
+            return count == 1;
+        }
+
+        base::ChannelElementBase::shared_ptr ConnectionManager::getCurrentChannel() const
+        {
+            ConnectionTable* t = acquireTable();
+            base::ChannelElementBase::shared_ptr result;
+            unsigned int current = t->current;
+            if ( current < t->size() && !t->at(current).removed )
+                result = t->at(current).descriptor.get<1>();
+            releaseTable(t);
+            return result;
+        }
+
+        std::list<ConnectionManager::ChannelDescriptor> ConnectionManager::getChannels() const
+        {
+            std::list<ChannelDescriptor> result;
+            ConnectionTable* t = acquireTable();
+            for (Connection* it = t->begin(); it != t->end(); ++it)
+                if ( !it->removed )
+                    result.push_back( it->descriptor );
+            releaseTable(t);
+            return result;
+        }
 
         void ConnectionManager::addConnection(ConnID* conn_id, ChannelElementBase::shared_ptr channel, ConnPolicy policy)
         { RTT::os::MutexLock lock(connection_lock);
             assert(conn_id);
-            ChannelDescriptor descriptor = boost::make_tuple(conn_id, channel, policy);
-            if (connections.empty())
-                cur_channel = descriptor;
-            connections.push_back(descriptor);
+            has_removed_connections = false;
+            ConnectionTable* new_table = copyTable();
+            new_table->connections.push_back( Connection( boost::make_tuple(conn_id, channel, policy) ) );
+            delete replaceTable( new_table );
         }
 
         bool ConnectionManager::removeConnection(ConnID* conn_id)
         {
             ChannelDescriptor descriptor;
             { RTT::os::MutexLock lock(connection_lock);
-                std::list<ChannelDescriptor>::iterator conn_it =
-                    std::find_if(connections.begin(), connections.end(), boost::bind(&ConnectionManager::findMatchingPort, this, conn_id, _1));
-                if (conn_it == connections.end())
+                has_removed_connections = false;
+                ConnectionTable* new_table = copyTable();
+                unsigned int i = 0;
+                while ( i != new_table->size() && !findMatchingPort(conn_id, new_table->at(i).descriptor) )
+                    ++i;
+                if ( i == new_table->size() ) {
+                    // only erase the queued connections, if any.
+                    if ( new_table->size() != table->size() )
+                        delete replaceTable( new_table );
+                    else
+                        delete new_table;
                     return false;
-                descriptor = *conn_it;
-                connections.erase(conn_it);
-                updateCurrentChannel( cur_channel.get<1>() == descriptor.get<1>() );
+                }
+                descriptor = new_table->at(i).descriptor;
+                new_table->connections.erase( new_table->connections.begin() + i );
+                // the first channel becomes the current one if the current was removed.
+                if ( new_table->current == i || new_table->current >= new_table->size() )
+                    new_table->current = 0;
+                else if ( new_table->current > i )
+                    --new_table->current;
+                delete replaceTable( new_table );
             }
 
             // disconnect needs to know if we're from Out->In (forward) or from In->Out
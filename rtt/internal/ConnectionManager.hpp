@@ -50,7 +50,9 @@
 #include "ConnID.hpp"
 #include "List.hpp"
 #include "../ConnPolicy.hpp"
+#include "../ConnectionStatistics.hpp"
 #include "../os/Mutex.hpp"
+#include "../os/oro_arch.h"
 #include "../base/rtt-base-fwd.hpp"
 #include "../base/ChannelElementBase.hpp"
 #include <boost/tuple/tuple.hpp>
@@ -61,6 +63,7 @@
 #include <rtt/os/Mutex.hpp>
 #include <rtt/os/MutexLock.hpp>
 #include <list>
+#include <vector>
 
 
 namespace RTT
@@ -72,7 +75,14 @@ namespace RTT
          * Manages connections between ports.
          * This class is used for input and output ports
          * in order to manage their channels.
-         * TODO: use the mutex lock !!!
+         *
+         * The connections are stored in an immutable table which is
+         * replaced as a whole (copy-on-write) when a connection is added or
+         * removed. delete_if() and select_reader_channel() iterate the
+         * current table without taking a lock and without allocating memory,
+         * such that (dis)connecting a port never blocks a real-time reader
+         * or writer. A table, and the channels it refers to, is only released
+         * after all threads stopped iterating it.
          */
         class RTT_API ConnectionManager
         {
@@ -115,20 +125,29 @@ namespace RTT
             /** Removes the channel that connects this port to \c port */
             bool disconnect(base::PortInterface* port);
 
+            /**
+             * Calls \a pred for each connection. When \a pred returns true,
+             * the connection is queued for removal: it is skipped from then on
+             * and is erased from the table by the next non real-time operation
+             * on this manager, or by removeInvalidConnections().
+             * This function is lock-free and does not allocate memory.
+             * @return true if a connection was queued for removal.
+             */
             template<typename Pred>
             bool delete_if(Pred pred) {
-                RTT::os::MutexLock lock(connection_lock);
+                ConnectionTable* table = acquireTable();
                 bool result = false;
-                std::list<ChannelDescriptor>::iterator it = connections.begin();
-                while (it != connections.end())
+                for (Connection* it = table->begin(); it != table->end(); ++it)
                 {
-                    if (pred(*it))
+                    if ( !it->removed && pred(it->descriptor) )
                     {
+                        it->removed = true;
                         result = true;
-                        it = connections.erase(it);
                     }
-                    else ++it;
                 }
+                if (result)
+                    has_removed_connections = true;
+                releaseTable(table);
                 return result;
             }
 
@@ -138,60 +157,74 @@ namespace RTT
              * the current channel ( getCurrentChannel() ), if that
              * does not satisfy pred, iterate over \b all connections.
              * If none satisfy pred, the current channel remains unchanged.
+             * This function is lock-free and does not allocate memory.
              * @param pred
              */
             template<typename Pred>
             void select_reader_channel(Pred pred, bool copy_old_data) {
-                RTT::os::MutexLock lock(connection_lock);
-                std::pair<bool, ChannelDescriptor> new_channel =
-                    find_if(pred, copy_old_data);
-                if (new_channel.first)
-                {
-                    // We don't clear the current channel (to get it to NoData state), because there is a race
-                    // between find_if and this line. We have to accept (in other parts of the code) that eventually,
-                    // all channels return 'OldData'.
-                    cur_channel = new_channel.second;
+                ConnectionTable* table = acquireTable();
+                // We only copy OldData in the initial read of the current channel.
+                // if it has no new data, the search over the other channels starts,
+                // but no old data is needed.
+                unsigned int current = table->current;
+                if ( current < table->size() && !table->at(current).removed && pred( copy_old_data, table->at(current).descriptor ) ) {
+                    releaseTable(table);
+                    return;
                 }
+                for (unsigned int i = 0; i != table->size(); ++i)
+                    if ( !table->at(i).removed && pred(false, table->at(i).descriptor) ) {
+                        // We don't clear the current channel (to get it to NoData state), because there is a race
+                        // between the search and this line. We have to accept (in other parts of the code) that eventually,
+                        // all channels return 'OldData'.
+                        table->current = i;
+                        break;
+                    }
+                releaseTable(table);
             }
 
             template<typename Pred>
             std::pair<bool, ChannelDescriptor> find_if(Pred pred, bool copy_old_data) {
-                // We only copy OldData in the initial read of the current channel.
-                // if it has no new data, the search over the other channels starts,
-                // but no old data is needed.
-                ChannelDescriptor channel = cur_channel;
-                if ( channel.get<1>() )
-                    if ( pred( copy_old_data, channel ) )
-                        return std::make_pair(true, channel);
-
-                std::list<ChannelDescriptor>::iterator result;
-                for (result = connections.begin(); result != connections.end(); ++result)
-                    if ( pred(false, *result) == true)
-                        return std::make_pair(true, *result);
-                return std::make_pair(false, ChannelDescriptor());
+                ConnectionTable* table = acquireTable();
+                std::pair<bool, ChannelDescriptor> result(false, ChannelDescriptor());
+                unsigned int current = table->current;
+                if ( current < table->size() && !table->at(current).removed && pred( copy_old_data, table->at(current).descriptor ) )
+                    result = std::make_pair(true, table->at(current).descriptor);
+                for (unsigned int i = 0; !result.first && i != table->size(); ++i)
+                    if ( !table->at(i).removed && pred(false, table->at(i).descriptor) )
+                        result = std::make_pair(true, table->at(i).descriptor);
+                releaseTable(table);
+                return result;
             }
 
             /**
              * Returns true if this manager manages only one connection.
              * @return
              */
-            bool isSingleConnection() const { return connections.size() == 1; }
+            bool isSingleConnection() const;
 
             /**
              * Returns the first added channel or if select_if was called, the selected channel.
              * @see select_if to change the current channel.
              * @return
              */
-            base::ChannelElementBase* getCurrentChannel() const {
-                return cur_channel.get<1>().get();
-            }
+            base::ChannelElementBase::shared_ptr getCurrentChannel() const;
 
             /**
              * Returns a list of all channels managed by this object.
              */
-            std::list<ChannelDescriptor> getChannels() const {
-                return connections;
-            }
+            std::list<ChannelDescriptor> getChannels() const;
+
+            /**
+             * Returns the data flow statistics of all connections of which
+             * the data is stored in this process, in the order they were added.
+             * This does not block the data path.
+             */
+            std::vector<ConnectionStatistics> getStatistics() const;
+
+            /**
+             * Clears the data flow statistics of all connections.
+             */
+            void resetStatistics() const;
 
             /**
              * Clears (removes) all data in the manager's connections.
@@ -200,9 +233,76 @@ namespace RTT
              */
             void clear();
 
+            /**
+             * Erases the connections that were queued for removal by delete_if()
+             * from the connection table. This allocates memory and may block
+             * until all real-time threads finished iterating the old table.
+             */
+            void removeInvalidConnections();
+
         protected:
+            /**
+             * An entry of the connection table.
+             */
+            struct Connection
+            {
+                Connection() : removed(false) {}
+                Connection(ChannelDescriptor const& descriptor) : descriptor(descriptor), removed(false) {}
+                ChannelDescriptor descriptor;
+                /** Set by delete_if() when the connection must be erased. */
+                bool volatile removed;
+            };
+
+            /**
+             * An immutable array of connections. Only the removed flags and the
+             * index of the current channel are modified once the table is
+             * published.
+             */
+            struct ConnectionTable
+            {
+                ConnectionTable() : current(0) { oro_atomic_set(&users, 0); }
+                Connection* begin() { return connections.empty() ? 0 : &connections[0]; }
+                Connection* end() { return begin() + connections.size(); }
+                unsigned int size() const { return connections.size(); }
+                Connection& at(unsigned int i) { return connections[i]; }
+                std::vector<Connection> connections;
+                /** Index of the current channel of an input port. */
+                unsigned int volatile current;
+                /** The number of threads iterating this table. */
+                mutable oro_atomic_t users;
+            };
 
-            void updateCurrentChannel(bool reset_current);
+            /**
+             * Returns the current table, which is not released until
+             * releaseTable() is called.
+             */
+            ConnectionTable* acquireTable() const {
+                ConnectionTable* result;
+                while (true) {
+                    result = table;
+                    oro_atomic_inc(&result->users);
+                    // the table may have been replaced between reading and pinning it.
+                    if (result == table)
+                        return result;
+                    oro_atomic_dec(&result->users);
+                }
+            }
+
+            void releaseTable(ConnectionTable* t) const {
+                oro_atomic_dec(&t->users);
+            }
+
+            /**
+             * Publishes \a new_table and waits until no thread uses the old
+             * table anymore, which is then returned. connection_lock must be held.
+             */
+            ConnectionTable* replaceTable(ConnectionTable* new_table);
+
+            /**
+             * Returns a copy of the current table without the connections that
+             * were removed. connection_lock must be held.
+             */
+            ConnectionTable* copyTable() const;
 
             /** Helper method for disconnect(PortInterface*)
              *
@@ -229,21 +329,20 @@ namespace RTT
             base::PortInterface* mport;
 
             /**
-             * A list of all our connections. Only non-null if two or more connections
-             * were added.
+             * The current table of connections. Never null.
              */
-            std::list< ChannelDescriptor > connections;
+            ConnectionTable* volatile table;
 
             /**
-             * Optimisation in case only one channel is to be managed.
+             * Set when delete_if() queued a connection for removal.
              */
-            ChannelDescriptor cur_channel;
+            bool volatile has_removed_connections;
 
             /**
-             * Lock that should be taken before the list of connections is
-             * accessed or modified
+             * Lock that serializes the replacement of the connection table.
+             * The data path never takes this lock.
              */
-            RTT::os::Mutex connection_lock;
+            mutable RTT::os::Mutex connection_lock;
         };
 
     }
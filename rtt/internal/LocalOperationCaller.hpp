@@ -43,6 +43,7 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <string>
+#include <vector>
 #include "Invoker.hpp"
 #include "../base/OperationCallerBase.hpp"
 #include "../base/OperationBase.hpp"
@@ -53,6 +54,7 @@
 #include "OperationCallerBinder.hpp"
 #include <boost/fusion/include/vector_tie.hpp>
 #include "../os/oro_allocator.hpp"
+#include "../os/CAS.hpp"
 
 #include <iostream>
 // For doing I/O
@@ -141,13 +143,13 @@ namespace RTT
             }
             // We need a handle object !
             SendHandle<Signature> send_impl() {
-                return do_send( this->cloneRT() );
+                return do_send( this->getSendClone() );
             }
 
             template<class T1>
             SendHandle<Signature> send_impl( T1 a1 ) {
                 // bind types from Storage<Function>
-                shared_ptr cl = this->cloneRT();
+                shared_ptr cl = this->getSendClone();
                 cl->store( a1 );
                 return do_send(cl);
             }
@@ -155,7 +157,7 @@ namespace RTT
             template<class T1, class T2>
             SendHandle<Signature> send_impl( T1 a1, T2 a2 ) {
                 // bind types from Storage<Function>
-                shared_ptr cl = this->cloneRT();
+                shared_ptr cl = this->getSendClone();
                 cl->store( a1,a2 );
                 return do_send(cl);
             }
@@ -163,7 +165,7 @@ namespace RTT
             template<class T1, class T2, class T3>
             SendHandle<Signature> send_impl( T1 a1, T2 a2, T3 a3 ) {
                 // bind types from Storage<Function>
-                shared_ptr cl = this->cloneRT();
+                shared_ptr cl = this->getSendClone();
                 cl->store( a1,a2,a3 );
                 return do_send(cl);
             }
@@ -171,7 +173,7 @@ namespace RTT
             template<class T1, class T2, class T3, class T4>
             SendHandle<Signature> send_impl( T1 a1, T2 a2, T3 a3, T4 a4 ) {
                 // bind types from Storage<Function>
-                shared_ptr cl = this->cloneRT();
+                shared_ptr cl = this->getSendClone();
                 cl->store( a1,a2,a3,a4 );
                 return do_send(cl);
             }
@@ -179,7 +181,7 @@ namespace RTT
             template<class T1, class T2, class T3, class T4, class T5>
             SendHandle<Signature> send_impl( T1 a1, T2 a2, T3 a3, T4 a4, T5 a5 ) {
                 // bind types from Storage<Function>
-                shared_ptr cl = this->cloneRT();
+                shared_ptr cl = this->getSendClone();
                 cl->store( a1,a2,a3,a4,a5 );
                 return do_send(cl);
             }
@@ -187,7 +189,7 @@ namespace RTT
             template<class T1, class T2, class T3, class T4, class T5, class T6>
             SendHandle<Signature> send_impl( T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6 ) {
                 // bind types from Storage<Function>
-                shared_ptr cl = this->cloneRT();
+                shared_ptr cl = this->getSendClone();
                 cl->store( a1,a2,a3,a4,a5,a6 );
                 return do_send(cl);
             }
@@ -195,7 +197,7 @@ namespace RTT
             template<class T1, class T2, class T3, class T4, class T5, class T6, class T7>
             SendHandle<Signature> send_impl( T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7 ) {
                 // bind types from Storage<Function>
-                shared_ptr cl = this->cloneRT();
+                shared_ptr cl = this->getSendClone();
                 cl->store( a1,a2,a3,a4,a5,a6,a7 );
                 return do_send(cl);
             }
@@ -616,7 +618,51 @@ namespace RTT
             }
 
             virtual shared_ptr cloneRT() const = 0;
+
+            bool setSendPoolDepth(unsigned int depth) {
+                if ( !os::CAS(&send_pool.busy, 0, 1) )
+                    return false;
+                // clones in use remain alive through their SendHandle.
+                send_pool.clones.clear();
+                send_pool.clones.reserve(depth);
+                for (unsigned int i = 0; i != depth; ++i)
+                    send_pool.clones.push_back( this->cloneRT() );
+                send_pool.next = 0;
+                send_pool.busy = 0;
+                return true;
+            }
+
         protected:
+            /**
+             * Returns a free clone from the send pool, or a newly
+             * allocated one if all clones are in use.
+             */
+            shared_ptr getSendClone() {
+                // an OperationCaller used from multiple threads falls back to cloneRT().
+                if ( !send_pool.clones.empty() && os::CAS(&send_pool.busy, 0, 1) ) {
+                    unsigned int n = send_pool.clones.size();
+                    for (unsigned int i = 0; i != n; ++i) {
+                        shared_ptr& cl = send_pool.clones[ (send_pool.next + i) % n ];
+                        // Only we can hand out new references to a clone that
+                        // is unique, its last user released it with an atomic
+                        // decrement after it was done with it.
+                        if ( cl.unique() ) {
+                            send_pool.next = (send_pool.next + i + 1) % n;
+                            cl->retv.executed = false;
+                            cl->retv.error = false;
+                            cl->myengine = this->myengine;
+                            cl->caller = this->caller;
+                            cl->met = this->met;
+                            shared_ptr ret = cl;
+                            send_pool.busy = 0;
+                            return ret;
+                        }
+                    }
+                    send_pool.busy = 0;
+                }
+                return this->cloneRT();
+            }
+
             typedef BindStorage<FunctionT> Store;
             /**
              * Used to refcount self as long as dispose() is not called.
@@ -624,6 +670,20 @@ namespace RTT
              * were allocated with the rt_allocator class.
              */
             typename base::OperationCallerBase<FunctionT>::shared_ptr self;
+
+            /**
+             * Preallocated clones for send(). A clone is free when
+             * only the pool refers to it. Copies of a caller do not
+             * share the clones.
+             */
+            struct SendPool {
+                std::vector<shared_ptr> clones;
+                unsigned int next;
+                int volatile busy;
+                SendPool() : next(0), busy(0) {}
+                SendPool(const SendPool&) : next(0), busy(0) {}
+                SendPool& operator=(const SendPool&) { return *this; }
+            } send_pool;
         };
 
         /**
@@ -0,0 +1,226 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  PaddedMWSRQueue.hpp
+
+                        PaddedMWSRQueue.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_PADDED_MWSR_QUEUE_HPP
+#define ORO_PADDED_MWSR_QUEUE_HPP
+
+#include "../os/CAS.hpp"
+#include "../os/oro_arch.h"
+
+namespace RTT
+{
+    namespace internal
+    {
+        /**
+         * An atomic, non-blocking Multi-Writer Single-Reader FIFO for storing
+         * a pointer \a T by value, with the same interface as AtomicMWSRQueue.
+         *
+         * The write and read indexes are free running counters, each on its
+         * own cache line. Writers only CAS the write index and the reader
+         * only stores the read index, so the reader never makes a writer's
+         * CAS fail and vice versa. The bits of a counter above the slot
+         * position act as a tag, which makes the CAS free of ABA problems.
+         * @warning You can not store null pointers.
+         * @param T The pointer type to be stored in the Queue.
+         * Example : PaddedMWSRQueue< A* > is a queue of pointers to A.
+         * @ingroup CoreLibBuffers
+         */
+        template<class T>
+        class PaddedMWSRQueue
+        {
+            typedef unsigned long index_t;
+
+            /**
+             * The slots, a null slot is free or not yet written.
+             * The pointer to the buffer can be cached,
+             * the contents are volatile.
+             */
+            T volatile* _buf;
+            const index_t _capacity;
+            /**
+             * The number of slots minus one, the number of
+             * slots is a power of two.
+             */
+            index_t _mask;
+
+            char _pad0[ORO_CACHELINE_SIZE];
+            /**
+             * The number of slots ever taken by writers.
+             */
+            volatile index_t _windex;
+            char _pad1[ORO_CACHELINE_SIZE - sizeof(index_t)];
+            /**
+             * The number of slots ever read by the reader.
+             */
+            volatile index_t _rindex;
+            char _pad2[ORO_CACHELINE_SIZE - sizeof(index_t)];
+
+            // non-copyable !
+            PaddedMWSRQueue(const PaddedMWSRQueue<T>&);
+        public:
+            typedef unsigned int size_type;
+
+            /**
+             * Create a PaddedMWSRQueue with queue size \a size.
+             * @param size The size of the queue, should be 1 or greater.
+             */
+            PaddedMWSRQueue(unsigned int size) :
+                _capacity(size), _mask(0)
+            {
+                index_t slots = 1;
+                while (slots < _capacity)
+                    slots <<= 1;
+                _mask = slots - 1;
+                _buf = new T[slots];
+                this->clear();
+            }
+
+            ~PaddedMWSRQueue()
+            {
+                delete[] _buf;
+            }
+
+            /**
+             * Inspect if the Queue is full.
+             * @return true if full, false otherwise.
+             */
+            bool isFull() const
+            {
+                index_t r = _rindex;
+                return _windex - r >= _capacity;
+            }
+
+            /**
+             * Inspect if the Queue is empty.
+             * @return true if empty, false otherwise.
+             */
+            bool isEmpty() const
+            {
+                return _windex == _rindex;
+            }
+
+            /**
+             * Return the maximum number of items this queue can contain.
+             */
+            size_type capacity() const
+            {
+                return _capacity;
+            }
+
+            /**
+             * Return the number of elements in the queue.
+             */
+            size_type size() const
+            {
+                index_t r = _rindex;
+                return _windex - r;
+            }
+
+            /**
+             * Enqueue an item.
+             * @param value The value to enqueue.
+             * @return false if queue is full, true if queued.
+             */
+            bool enqueue(const T& value)
+            {
+                if (value == 0)
+                    return false;
+                index_t r, w;
+                do
+                {
+                    // read the reader's index first, such that w - r can not underflow.
+                    r = _rindex;
+                    w = _windex;
+                    if (w - r >= _capacity)
+                        return false;
+                } while (!os::CAS(&_windex, w, w + 1));
+                // from here on, slot w is ours. It was emptied by the reader
+                // before it advanced past w - capacity. The reader will wait
+                // for it until it is written.
+                _buf[w & _mask] = value;
+                return true;
+            }
+
+            /**
+             * Dequeue an item.
+             * @param value Stores the dequeued value. It is unchanged when
+             * dequeue returns false and contains the dequeued value
+             * when it returns true.
+             * @return false if queue is empty, true if result was written.
+             */
+            bool dequeue(T& result)
+            {
+                index_t r = _rindex;
+                T value = _buf[r & _mask];
+                // return it if not yet written:
+                if ( !value )
+                    return false;
+                // got it, clear field before releasing the slot.
+                _buf[r & _mask] = 0;
+                _rindex = r + 1;
+                result = value;
+                return true;
+            }
+
+            /**
+             * Return the next to be read value.
+             */
+            const T front() const
+            {
+                return _buf[_rindex & _mask];
+            }
+
+            /**
+             * Clear all contents of the Queue and thus make it empty.
+             */
+            void clear()
+            {
+                for (index_t i = 0; i <= _mask; ++i)
+                {
+                    _buf[i] = 0;
+                }
+                _windex = 0;
+                _rindex = 0;
+            }
+
+        };
+
+    }
+}
+#endif
@@ -0,0 +1,238 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  PaddedTsPool.hpp
+
+                        PaddedTsPool.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef RTT_PADDED_TSPOOL_HPP_
+#define RTT_PADDED_TSPOOL_HPP_
+
+#include "../os/CAS.hpp"
+#include "../os/oro_arch.h"
+#include <assert.h>
+
+namespace RTT
+{
+    namespace internal
+    {
+
+        /**
+         * A multi-reader multi-writer MemoryPool implementation with the
+         * same interface as TsPool.
+         *
+         * The head of the free list is a tagged index on its own cache line.
+         * Index and tag each take half of an unsigned long, so the pool can
+         * hold up to 2^32 - 2 elements on 64-bit platforms and 65534 elements
+         * on 32-bit platforms.
+         */
+        template<typename T>
+        class PaddedTsPool
+        {
+        public:
+            typedef T value_t;
+        private:
+            typedef unsigned long Pointer_t;
+
+            static const unsigned int index_bits = sizeof(Pointer_t) * 4;
+            static const Pointer_t index_mask = (Pointer_t(1) << index_bits) - 1;
+            /** Marks the end of the free list. */
+            static const Pointer_t nil = index_mask;
+
+            static Pointer_t index(Pointer_t p) { return p & index_mask; }
+            /** Returns \a index tagged with the tag of \a old plus one. */
+            static Pointer_t retag(Pointer_t old, Pointer_t index) { return ((old & ~index_mask) + index_mask + 1) | index; }
+
+            /**
+             * The implementation assumes that value
+             * is the first element of this struct
+             * and that there are no virtual functions in this class.
+             */
+            struct Item
+            {
+                value_t value;
+                volatile Pointer_t next;
+
+                Item() :
+                    value(value_t()), next(0)
+                {
+                }
+            };
+
+            Item* pool;
+            unsigned int pool_capacity;
+
+            char pad0[ORO_CACHELINE_SIZE];
+            volatile Pointer_t head;
+            char pad1[ORO_CACHELINE_SIZE - sizeof(Pointer_t)];
+        public:
+
+            typedef unsigned int size_type;
+
+            /**
+             * The maximum capacity of a pool on this platform.
+             */
+            static size_type max_capacity() { return size_type(nil - 1); }
+
+            /**
+             * Creates a fixed size memory pool holding \a ssize
+             * blocks of memory that can hold an object of class \a T.
+             */
+            PaddedTsPool(unsigned int ssize, const T& sample = T()) :
+                pool_capacity(ssize), head(nil)
+            {
+                assert( ssize <= max_capacity() );
+                pool = new Item[ssize];
+                data_sample( sample );
+            }
+
+            ~PaddedTsPool()
+            {
+#ifndef NDEBUG
+                /*Check pool consistency.*/
+                unsigned int i = 0, endseen = 0;
+                for (; i < pool_capacity; i++)
+                {
+                    if (index(pool[i].next) == nil)
+                    {
+                        ++endseen;
+                    }
+                }
+                assert( (endseen == 1 || pool_capacity == 0) );
+                assert( size() == pool_capacity && "PaddedTsPool: not all pieces were deallocated !" );
+#endif
+                delete[] pool;
+            }
+
+            /**
+             * Clears all internal management data of this Memory Pool.
+             * All data blobs are considered to be owned by the pool
+             * again.
+             * @nts
+             * @rt
+             */
+            void clear()
+            {
+                for (unsigned int i = 0; i < pool_capacity; i++)
+                {
+                    pool[i].next = i + 1;
+                }
+                if (pool_capacity == 0) {
+                    head = nil;
+                    return;
+                }
+                pool[pool_capacity - 1].next = nil;
+                head = retag(head, 0);
+            }
+
+            /**
+             * Initializes every element of the pool with the given sample
+             * and clears the pool.
+             * @nts
+             * @nrt
+             */
+            void data_sample(const T& sample) {
+                for (unsigned int i = 0; i < pool_capacity; i++)
+                    pool[i].value = sample;
+                clear();
+            }
+
+            value_t* allocate()
+            {
+                Pointer_t oldval, newval;
+                Item* item;
+                do
+                {
+                    oldval = head;
+                    //List empty?
+                    if (index(oldval) == nil)
+                    {
+                        return 0;
+                    }
+                    item = &pool[index(oldval)];
+                    newval = retag(oldval, index(item->next));
+                } while (!os::CAS(&head, oldval, newval));
+                return &item->value;
+            }
+
+            bool deallocate(T* Value)
+            {
+                if (Value == 0)
+                {
+                    return false;
+                }
+                assert(Value >= (T*) &pool[0] && Value <= (T*) &pool[pool_capacity]);
+                Pointer_t oldval, newval;
+                Item* item = reinterpret_cast<Item*> (Value);
+                do
+                {
+                    oldval = head;
+                    item->next = index(oldval);
+                    newval = retag(oldval, item - pool);
+                } while (!os::CAS(&head, oldval, newval));
+                return true;
+            }
+
+            /**
+             * Return the number of elements that are available to be allocated.
+             * This function is not thread-safe and should not be used when concurrent
+             * allocate()/deallocate() functions are running.
+             * @return the number of elements left to allocate.
+             */
+            unsigned int size()
+            {
+                unsigned int ret = 0;
+                Pointer_t next = index(head);
+                while ( next != nil ) {
+                    ++ret;
+                    next = index(pool[next].next);
+                    assert(ret <= pool_capacity); // abort on corruption due to concurrency.
+                }
+                return ret;
+            }
+
+            /**
+             * The maximum number of elements available for allocation.
+             * @return The maximum size.
+             */
+            unsigned int capacity()
+            {
+                return pool_capacity;
+            }
+        };
+    }
+}
+
+#endif /* RTT_PADDED_TSPOOL_HPP_ */
@@ -91,6 +91,8 @@ namespace RTT {
         template<class T>
         class MWSRQueue;
         template<class T>
+        class PaddedMWSRQueue;
+        template<class T>
         class Queue;
         template<class T>
         struct AStore;
@@ -157,6 +159,8 @@ namespace RTT {
         template<typename T>
         class PartDataSource;
         template<typename T>
+        class PaddedTsPool;
+        template<typename T>
         class ReferenceDataSource;
         template<typename T>
         class TsPool;
@@ -0,0 +1,153 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  CPFBlob.cpp
+
+                        CPFBlob.cpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "CPFBlob.hpp"
+#include <cstring>
+#include <algorithm>
+
+namespace RTT
+{ namespace marsh {
+
+    namespace {
+        const char base64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        /**
+         * Returns the 6 bit value of a base64 character, or -1.
+         */
+        int base64Value( char c )
+        {
+            if ( c >= 'A' && c <= 'Z' ) return c - 'A';
+            if ( c >= 'a' && c <= 'z' ) return c - 'a' + 26;
+            if ( c >= '0' && c <= '9' ) return c - '0' + 52;
+            if ( c == '+' ) return 62;
+            if ( c == '/' ) return 63;
+            return -1;
+        }
+
+        bool isLittleEndian()
+        {
+            const unsigned int one = 1;
+            return *reinterpret_cast<const unsigned char*>(&one) == 1;
+        }
+
+        /**
+         * Copies a double from or to its little endian byte representation.
+         */
+        void toLittleEndian( const double& d, unsigned char* bytes )
+        {
+            std::memcpy( bytes, &d, sizeof(double) );
+            if ( !isLittleEndian() )
+                for ( unsigned int i = 0; i != sizeof(double) / 2; ++i )
+                    std::swap( bytes[i], bytes[sizeof(double) - 1 - i] );
+        }
+
+        void fromLittleEndian( const unsigned char* bytes, double& d )
+        {
+            unsigned char tmp[sizeof(double)];
+            std::memcpy( tmp, bytes, sizeof(double) );
+            if ( !isLittleEndian() )
+                for ( unsigned int i = 0; i != sizeof(double) / 2; ++i )
+                    std::swap( tmp[i], tmp[sizeof(double) - 1 - i] );
+            std::memcpy( &d, tmp, sizeof(double) );
+        }
+    }
+
+    std::string encodeDoubles( const std::vector<double>& values )
+    {
+        std::vector<unsigned char> bytes( values.size() * sizeof(double) );
+        for ( unsigned int i = 0; i != values.size(); ++i )
+            toLittleEndian( values[i], &bytes[i * sizeof(double)] );
+
+        std::string result;
+        result.reserve( (bytes.size() + 2) / 3 * 4 );
+        unsigned int i = 0;
+        for ( ; i + 2 < bytes.size(); i += 3 ) {
+            unsigned int n = (bytes[i] << 16) | (bytes[i+1] << 8) | bytes[i+2];
+            result += base64_chars[ (n >> 18) & 63 ];
+            result += base64_chars[ (n >> 12) & 63 ];
+            result += base64_chars[ (n >> 6) & 63 ];
+            result += base64_chars[ n & 63 ];
+        }
+        if ( i + 1 == bytes.size() ) {
+            unsigned int n = bytes[i] << 16;
+            result += base64_chars[ (n >> 18) & 63 ];
+            result += base64_chars[ (n >> 12) & 63 ];
+            result += "==";
+        } else if ( i + 2 == bytes.size() ) {
+            unsigned int n = (bytes[i] << 16) | (bytes[i+1] << 8);
+            result += base64_chars[ (n >> 18) & 63 ];
+            result += base64_chars[ (n >> 12) & 63 ];
+            result += base64_chars[ (n >> 6) & 63 ];
+            result += '=';
+        }
+        return result;
+    }
+
+    bool decodeDoubles( const std::string& text, std::vector<double>& values )
+    {
+        std::vector<unsigned char> bytes;
+        bytes.reserve( text.size() / 4 * 3 );
+        unsigned int n = 0, bits = 0;
+        bool padding = false;
+        for ( std::string::const_iterator it = text.begin(); it != text.end(); ++it ) {
+            if ( *it == ' ' || *it == '\t' || *it == '\n' || *it == '\r' )
+                continue;
+            if ( *it == '=' ) {
+                padding = true;
+                continue;
+            }
+            int v = base64Value( *it );
+            if ( v < 0 || padding )
+                return false;
+            n = (n << 6) | v;
+            bits += 6;
+            if ( bits >= 8 ) {
+                bits -= 8;
+                bytes.push_back( (n >> bits) & 0xff );
+            }
+        }
+        if ( bytes.size() % sizeof(double) != 0 )
+            return false;
+
+        values.resize( bytes.size() / sizeof(double) );
+        for ( unsigned int i = 0; i != values.size(); ++i )
+            fromLittleEndian( &bytes[i * sizeof(double)], values[i] );
+        return true;
+    }
+}}
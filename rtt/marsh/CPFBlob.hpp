@@ -0,0 +1,76 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  CPFBlob.hpp
+
+                        CPFBlob.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_CPF_BLOB_HPP
+#define ORO_CPF_BLOB_HPP
+
+#include <string>
+#include <vector>
+#include "rtt-marsh-config.h"
+
+namespace RTT
+{ namespace marsh {
+
+    /**
+     * Encodes \a values in the format of a CPF \c array value with
+     * \c encoding="base64": the base64 text of the little endian IEEE 754
+     * representation of each double. This is much more compact to store and
+     * parse than a sequence of \c simple elements.
+     * For example: @verbatim
+       <simple name="gains" type="array" encoding="base64"><value>AAAAAAAA8D8AAAAAAAAAQA==</value></simple>
+       @endverbatim
+     * holds the values 1.0 and 2.0.
+     * @param values The doubles to encode.
+     * @return The base64 encoded text.
+     */
+    RTT_MARSH_API std::string encodeDoubles( const std::vector<double>& values );
+
+    /**
+     * Decodes the value of a CPF \c array with \c encoding="base64".
+     * White space in \a text is ignored.
+     * @param text The base64 encoded text.
+     * @param values Receives the decoded doubles.
+     * @return false if \a text is not valid base64 or does not contain a
+     * whole number of doubles.
+     * @see encodeDoubles()
+     */
+    RTT_MARSH_API bool decodeDoubles( const std::string& text, std::vector<double>& values );
+}}
+
+#endif
@@ -63,6 +63,7 @@
 #include <Property.hpp>
 #include "../base/PropertyIntrospection.hpp"
 #include <Logger.hpp>
+#include "CPFBlob.hpp"
 
 namespace RTT
 {
@@ -117,6 +118,10 @@ namespace RTT
             std::string name;
             std::string description;
             std::string type;
+            /**
+             * The encoding attribute of a simple element.
+             */
+            std::string encoding;
             std::string value_string;
 
         public:
@@ -211,6 +216,16 @@ namespace RTT
                         else if ( type == "string")
                             bag_stack.top().first->add
                             ( new Property<std::string>( name, description, value_string ) );
+                        else if ( type == "array" )
+                        {
+                            std::vector<double> v;
+                            if ( encoding == "base64" && decodeDoubles( value_string, v ) )
+                                bag_stack.top().first->add
+                                    ( new Property<std::vector<double> >( name, description, v ) );
+                            else
+                                throw SAXException(std::string("Wrong value for property '"+name+"' of type '"+type+"'." \
+                                                               " Value should contain base64 encoded doubles and have encoding='base64'.").c_str());
+                        }
                         tag_stack.pop();
                         value_string.clear(); // cleanup
                         description.clear();
@@ -265,6 +280,7 @@ namespace RTT
                     {
                         name.clear();
                         type.clear();
+                        encoding.clear();
                         tag_stack.push( TAG_SIMPLE );
                         for (unsigned int ac = 0; ac < attributes.getLength(); ++ac)
                         {
@@ -278,6 +294,10 @@ namespace RTT
                             {
                                 XMLChToStdString( attributes.getValue(ac), type);
                             }
+                            else if ( an == "encoding")
+                            {
+                                XMLChToStdString( attributes.getValue(ac), encoding);
+                            }
                         }
                     }
                     else
@@ -361,7 +381,12 @@ namespace RTT
                         break;
 
                     case TAG_VALUE:
-                        XMLChToStdString( chars, value_string);
+                        {
+                            // large values may be delivered in several chunks.
+                            std::string chunk;
+                            XMLChToStdString( chars, chunk);
+                            value_string += chunk;
+                        }
                         break;
                     case TAG_STRUCT:
                     case TAG_SIMPLE:
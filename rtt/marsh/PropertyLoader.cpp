@@ -53,6 +53,22 @@ using namespace std;
 using namespace RTT;
 using namespace RTT::detail;
 
+namespace {
+    /**
+     * Makes a deep copy of those properties of \a target which are
+     * refreshed by \a source, such that a failed refresh can be rolled
+     * back without copying all properties of \a target.
+     */
+    void backupProperties( PropertyBag& backup, const PropertyBag& target, const PropertyBag& source )
+    {
+        PropertyBag touched;
+        for( PropertyBag::const_iterator it = target.begin(); it != target.end(); ++it)
+            if ( (*it)->getName().empty() || source.find( (*it)->getName() ) )
+                touched.add( *it );
+        copyProperties( backup, touched );
+    }
+}
+
 PropertyLoader::PropertyLoader(TaskContext *task)
   : target(task->provides().get())
 {}
@@ -97,9 +113,9 @@ bool PropertyLoader::load(const std::string& filename) const
                 delete demarshaller;
                 return false;
             }
-            // take restore-copy;
+            // take restore-copy of the properties we will touch;
             PropertyBag backup;
-            copyProperties( backup, *target->properties() );
+            backupProperties( backup, *target->properties(), composed_props );
             // First test if the updateProperties will succeed:
             if ( refreshProperties(  *target->properties(), composed_props, false) ) { // not strict
                 // this just adds the new properties, *should* never fail, but
@@ -118,6 +134,7 @@ bool PropertyLoader::load(const std::string& filename) const
                 log(Error) << "Some error occured while parsing "<< filename.c_str() <<endlog();
                 failure = true;
             }
+        deletePropertyBag( propbag );
     } catch (...)
     {
         log(Error)
@@ -165,12 +182,12 @@ bool PropertyLoader::configure(const std::string& filename, bool all ) const
                 delete demarshaller;
                 return false;
             }
-            // take restore-copy;
+            // take restore-copy of the properties we will touch;
             PropertyBag backup;
-            copyProperties( backup, *target->properties() );
+            backupProperties( backup, *target->properties(), composed_props );
             if ( refreshProperties( *target->properties(), composed_props, all ) == false ) {
                 // restore backup:
-                refreshProperties( *target->properties(), backup );
+                refreshProperties( *target->properties(), backup, false ); // not strict
                 failure = true;
                 }
             // cleanup
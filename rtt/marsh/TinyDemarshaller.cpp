@@ -56,6 +56,7 @@ using namespace std;
 #include <Property.hpp>
 #include <PropertyBag.hpp>
 #include <Logger.hpp>
+#include "CPFBlob.hpp"
 
 namespace RTT
 {
@@ -78,6 +79,10 @@ namespace RTT
             std::string name;
             std::string description;
             std::string type;
+            /**
+             * The encoding attribute of a simple element.
+             */
+            std::string encoding;
             std::string value_string;
 
         public:
@@ -184,6 +189,18 @@ namespace RTT
                         else if ( type == "string")
                             bag_stack.top().first->add
                             ( new Property<std::string>( name, description, value_string ) );
+                        else if ( type == "array" )
+                        {
+                            std::vector<double> v;
+                            if ( encoding == "base64" && decodeDoubles( value_string, v ) )
+                                bag_stack.top().first->add
+                                    ( new Property<std::vector<double> >( name, description, v ) );
+                            else {
+                                log(Error) << "Wrong value for property '"+name+"' of type '"+type+"'." \
+                                    " Value should contain base64 encoded doubles and have encoding='base64'." << endlog();
+                                return false;
+                            }
+                        }
                         else{
                         	log(Error)<<"Unknown type \""<<type<< "\" for for tag simple"<<endlog();
                         	return false;
@@ -241,6 +258,7 @@ namespace RTT
                         tag_stack.push( TAG_SIMPLE );
                         name.clear();
                         type.clear();
+                        encoding.clear();
                         while (attributes)
                         {
                             std::string an = attributes->Name();
@@ -252,6 +270,10 @@ namespace RTT
                             {
                                 type = attributes->Value();
                             }
+                            else if ( an == "encoding")
+                            {
+                                encoding = attributes->Value();
+                            }
                             attributes = attributes->Next();
                         }
                     }
@@ -409,7 +431,12 @@ namespace RTT
 
         detail::Tiny2CPFHandler proc( v );
 
-        if ( proc.populateBag( propHandle.Node() ) == false) {
+        bool result = proc.populateBag( propHandle.Node() );
+        // v holds all data now, release the document before the caller
+        // processes the properties.
+        d->doc.Clear();
+        d->loadOkay = false;
+        if ( result == false) {
             deleteProperties( v );
             return false;
         }
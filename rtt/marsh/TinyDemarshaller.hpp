@@ -58,6 +58,10 @@ namespace RTT
     public:
         TinyDemarshaller( const std::string& filename );
         ~TinyDemarshaller();
+        /**
+         * Reads the properties of the file into \a v. The parsed document
+         * is released afterwards, so this can only be done once.
+         */
         virtual bool deserialize( PropertyBag &v );
     };
 }}
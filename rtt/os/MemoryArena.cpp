@@ -0,0 +1,114 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  MemoryArena.cpp
+
+                        MemoryArena.cpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "MemoryArena.hpp"
+#include "oro_malloc.h"
+
+namespace RTT
+{ namespace os {
+
+    MemoryStats::MemoryStats()
+        : size(0), used(0), max_used(0), largest_free(0), remote_frees(0), arena(false)
+    {}
+
+    double MemoryStats::fragmentation() const
+    {
+        if ( size <= used )
+            return 0.0;
+        double free_size = double(size - used);
+        if ( largest_free >= free_size )
+            return 0.0;
+        return 1.0 - largest_free / free_size;
+    }
+
+#ifdef OS_RT_MALLOC
+    void* attachMemoryArena(std::size_t size)
+    {
+        if ( oro_rt_arena_current() )
+            return 0;
+        void* arena = oro_rt_arena_create(size);
+        if (arena)
+            oro_rt_arena_attach(arena);
+        return arena;
+    }
+
+    void releaseMemoryArena()
+    {
+        oro_rt_arena_release( oro_rt_arena_current() );
+    }
+
+    void* currentMemoryArena()
+    {
+        return oro_rt_arena_current();
+    }
+
+    bool getMemoryStats(MemoryStats& stats, void* arena)
+    {
+        struct tlsf_stats s;
+        if ( oro_rt_arena_stats(arena, &s) != 0 )
+            return false;
+        stats.size = s.size;
+        stats.used = s.used;
+        stats.max_used = s.max_used;
+        stats.largest_free = s.largest_free;
+        stats.remote_frees = s.remote_frees;
+        stats.arena = s.arena != 0;
+        return true;
+    }
+#else
+    void* attachMemoryArena(std::size_t)
+    {
+        return 0;
+    }
+
+    void releaseMemoryArena()
+    {
+    }
+
+    void* currentMemoryArena()
+    {
+        return 0;
+    }
+
+    bool getMemoryStats(MemoryStats&, void*)
+    {
+        return false;
+    }
+#endif
+}}
@@ -0,0 +1,132 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  MemoryArena.hpp
+
+                        MemoryArena.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef RTT_OS_MEMORYARENA_HPP
+#define RTT_OS_MEMORYARENA_HPP
+
+#include "../rtt-config.h"
+#include <cstddef>
+
+namespace RTT
+{ namespace os {
+
+    /**
+     * Statistics of a real-time memory pool, as returned by
+     * getMemoryStats(). The values are read without locking the pool
+     * and may be slightly out of date when the pool is in use by
+     * another thread.
+     */
+    struct RTT_API MemoryStats
+    {
+        MemoryStats();
+
+        /**
+         * The number of bytes managed by the pool.
+         */
+        std::size_t size;
+        /**
+         * The number of bytes in use, including the allocator's overhead.
+         * Zero if RTT was built without OS_RT_MALLOC_STATS.
+         */
+        std::size_t used;
+        /**
+         * The peak of \a used.
+         */
+        std::size_t max_used;
+        /**
+         * A lower bound of the largest block that can still be allocated
+         * without growing the pool.
+         */
+        std::size_t largest_free;
+        /**
+         * The number of blocks of this pool that were freed by other threads.
+         */
+        unsigned long remote_frees;
+        /**
+         * True if this pool is a thread's memory arena, false for the
+         * shared pool.
+         */
+        bool arena;
+
+        /**
+         * The fragmentation of the free memory, between 0 (all free memory
+         * is one block) and 1.
+         */
+        double fragmentation() const;
+    };
+
+    /**
+     * Creates a private real-time memory arena of \a size bytes and
+     * attaches it to the calling thread. From then on, oro_rt_malloc()
+     * and os::rt_allocator allocate from this arena without taking a lock.
+     * Memory freed by other threads is handed back to the arena through a
+     * lock-free queue. When the arena is exhausted, allocations fall back
+     * to the shared pool.
+     *
+     * @return an opaque handle to the arena, or zero if the calling thread
+     * already has an arena or if arenas are not supported by this build.
+     * @see Thread::setMemoryArenaSize() to give each Thread an arena.
+     */
+    RTT_API void* attachMemoryArena(std::size_t size);
+
+    /**
+     * Detaches the calling thread's arena and releases it. The memory
+     * still in use by other threads remains valid, the arena is reused
+     * once all of it has been freed.
+     */
+    RTT_API void releaseMemoryArena();
+
+    /**
+     * Returns the arena of the calling thread, or zero if it allocates
+     * from the shared pool.
+     */
+    RTT_API void* currentMemoryArena();
+
+    /**
+     * Reads the statistics of a real-time memory pool.
+     * @param stats is filled in with the statistics.
+     * @param arena An arena returned by attachMemoryArena(), or zero for
+     * the shared pool.
+     * @return false if RTT was built without OS_RT_MALLOC or if the pool
+     * was not yet created.
+     */
+    RTT_API bool getMemoryStats(MemoryStats& stats, void* arena = 0);
+}}
+
+#endif
@@ -61,16 +61,47 @@ namespace RTT {
 
         unsigned int Thread::default_stack_size = 0;
 
+        unsigned int Thread::default_arena_size = 0;
+
         double Thread::lock_timeout_no_period_in_s = 1.0;
 
         double Thread::lock_timeout_period_factor = 10.0;
 
         void Thread::setStackSize(unsigned int ssize) { default_stack_size = ssize; }
 
+        void Thread::setMemoryArenaSize(unsigned int asize) { default_arena_size = asize; }
+
         void Thread::setLockTimeoutNoPeriod(double timeout_in_s) { lock_timeout_no_period_in_s = timeout_in_s; }
        
         void Thread::setLockTimeoutPeriodFactor(double factor) { lock_timeout_period_factor = factor; }
 
+        namespace {
+            /**
+             * The clock on which periodic threads are scheduled.
+             */
+            NANO_TIME statistics_time()
+            {
+#ifdef OROPKG_OS_GNULINUX
+                return rtos_get_time_monotonic_ns();
+#else
+                return rtos_get_time_ns();
+#endif
+            }
+
+            void update_min_max_mean(double value, unsigned int count, double& min, double& max, double& mean)
+            {
+                if ( count == 1 ) {
+                    min = max = mean = value;
+                    return;
+                }
+                if ( value < min )
+                    min = value;
+                if ( value > max )
+                    max = value;
+                mean += (value - mean) / count;
+            }
+        }
+
         void *thread_function(void* t)
         {
             /**
@@ -79,6 +110,9 @@ namespace RTT {
             Thread* task = static_cast<os::Thread*> (t);
             Logger::In in(task->getName());
 
+            if ( Thread::default_arena_size != 0 )
+                task->marena = attachMemoryArena( Thread::default_arena_size );
+
             task->configure();
 
             // signal to setup() that we're created.
@@ -94,6 +128,9 @@ namespace RTT {
 
             int overruns = 0, cur_sched = task->msched_type;
             NANO_TIME cur_period = task->period;
+            // the statistics are only written by this thread.
+            ThreadStatistics stats;
+            NANO_TIME last_wake = 0, scheduled_wake = 0;
 
             while (!task->prepareForExit)
             {
@@ -125,8 +162,27 @@ namespace RTT {
                             if (task->period != 0) // periodic
                             {
                                 MutexLock lock(task->breaker);
+                                // the first wake-up is the start of the schedule.
+                                last_wake = 0;
                                 while(task->running && !task->prepareForExit )
                                 {
+                                    if ( task->statisticsReset ) {
+                                        task->statisticsReset = false;
+                                        stats.reset();
+                                    }
+                                    NANO_TIME wake = statistics_time();
+                                    if ( last_wake != 0 ) {
+                                        nsecs jitter = wake - last_wake - cur_period;
+                                        if ( jitter < 0 )
+                                            jitter = -jitter;
+                                        ++stats.jitter_histogram[ ThreadStatistics::jitterBucket(jitter) ];
+                                        if ( nsecs_to_Seconds(jitter) > stats.jitter_max )
+                                            stats.jitter_max = nsecs_to_Seconds(jitter);
+                                        nsecs latency = wake > scheduled_wake ? wake - scheduled_wake : 0;
+                                        ++stats.wakeups;
+                                        update_min_max_mean( nsecs_to_Seconds(latency), stats.wakeups, stats.latency_min, stats.latency_max, stats.latency_mean );
+                                    }
+
                                     TRY
                                     (
                                         SCOPE_ON
@@ -139,11 +195,24 @@ namespace RTT {
                                         throw;
                                     )
 
+                                    ++stats.cycles;
+                                    update_min_max_mean( nsecs_to_Seconds(statistics_time() - wake), stats.cycles, stats.step_min, stats.step_max, stats.step_mean );
+                                    task->statistics.Set( stats );
+
+                                    // the wake-up time rtos_task_wait_period() aims for:
+                                    // with ORO_WAIT_REL it is one period after this wake-up.
+                                    if ( last_wake == 0 || task->waitPolicy != 0 )
+                                        scheduled_wake = wake + cur_period;
+                                    else
+                                        scheduled_wake += cur_period;
+                                    last_wake = wake;
+
                                     // Check changes in period
                                     if ( cur_period != task->period) {
                                         // reconfigure period before going to sleep
                                         rtos_task_set_period(task->getTask(), task->period);
                                         cur_period = task->period;
+                                        last_wake = 0; // restarts the schedule.
                                         if (cur_period == 0)
                                             break; // break while(task->running) if no longer periodic
                                     }
@@ -158,6 +227,7 @@ namespace RTT {
                                     // return non-zero to indicate overrun.
                                     if (rtos_task_wait_period(task->getTask()) != 0)
                                     {
+                                        ++stats.overruns;
                                         ++overruns;
                                         if (overruns == task->maxOverRun)
                                             break; // break while(task->running)
@@ -219,9 +289,19 @@ namespace RTT {
                 )
             } // while (!prepareForExit)
 
+            if ( task->marena ) {
+                task->marena = 0;
+                releaseMemoryArena();
+            }
             return 0;
         }
 
+        bool Thread::getMemoryStats(MemoryStats& stats) const
+        {
+            void* arena = marena;
+            return arena != 0 && os::getMemoryStats(stats, arena);
+        }
+
         void Thread::emergencyStop()
         {
             // set state to not running
@@ -241,7 +321,7 @@ namespace RTT {
 #ifdef OROPKG_OS_THREAD_SCOPE
         ,d(NULL)
 #endif
-                    , stopTimeout(0)
+                    , stopTimeout(0), waitPolicy(0), statisticsReset(false), marena(0)
         {
             this->setup(_priority, cpu_affinity, name);
         }
@@ -645,9 +725,20 @@ namespace RTT {
 
         void Thread::setWaitPeriodPolicy(int p)
         {
+            waitPolicy = p;
             rtos_task_set_wait_period_policy(&rtos_task, p);  
         }
 
+        ThreadStatistics Thread::getStatistics() const
+        {
+            return statistics.Get();
+        }
+
+        void Thread::resetStatistics()
+        {
+            statisticsReset = true;
+        }
+
     }
 }
 
@@ -44,6 +44,8 @@
 
 #include "ThreadInterface.hpp"
 #include "Mutex.hpp"
+#include "MemoryArena.hpp"
+#include "../base/DataObjectSeqLock.hpp"
 
 #include <string>
 
@@ -136,6 +138,24 @@ namespace RTT
              */
             static void setStackSize(unsigned int ssize);
 
+            /**
+             * Sets the size of the private real-time memory arena of the
+             * threads to be created. Each such thread allocates with
+             * oro_rt_malloc() from its own arena, without taking a lock.
+             * Use zero (the default) to allocate from the shared pool.
+             * This has no effect if RTT was built without OS_RT_MALLOC.
+             * @param asize the initial size of each arena in bytes
+             * @see attachMemoryArena()
+             */
+            static void setMemoryArenaSize(unsigned int asize);
+
+            /**
+             * Reads the statistics of this thread's real-time memory arena.
+             * @return false if this thread has no arena.
+             * @see setMemoryArenaSize()
+             */
+            bool getMemoryStats(MemoryStats& stats) const;
+
             /**
              * Sets the lock timeout for a thread which does not have a period
              * The default is 1 second 
@@ -240,6 +260,10 @@ namespace RTT
 
             virtual void setWaitPeriodPolicy(int p);
 
+            virtual ThreadStatistics getStatistics() const;
+
+            virtual void resetStatistics();
+
         protected:
             /**
              * Exit and destroy the thread
@@ -286,6 +310,8 @@ namespace RTT
 
             static unsigned int default_stack_size;
 
+            static unsigned int default_arena_size;
+
             /**
              *  configuration of the lock timeout in seconds
              */
@@ -353,6 +379,27 @@ namespace RTT
              */
             double stopTimeout;
 
+            /**
+             * The wait policy as set by setWaitPeriodPolicy().
+             */
+            int waitPolicy;
+
+            /**
+             * The scheduling statistics, which are written by
+             * the thread itself after each step().
+             */
+            base::DataObjectSeqLock<ThreadStatistics> statistics;
+
+            /**
+             * Requests the thread to clear its statistics.
+             */
+            volatile bool statisticsReset;
+
+            /**
+             * The memory arena of this thread, if any.
+             */
+            void* volatile marena;
+
 #ifdef OROPKG_OS_THREAD_SCOPE
             // Pointer to Threadscope device
             dev::DigitalOutInterface * d;
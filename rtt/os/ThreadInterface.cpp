@@ -59,3 +59,12 @@ bool ThreadInterface::isSelf() const
 {
     return rtos_task_is_self( this->getTask() ) == 1;
 }
+
+ThreadStatistics ThreadInterface::getStatistics() const
+{
+    return ThreadStatistics();
+}
+
+void ThreadInterface::resetStatistics()
+{
+}
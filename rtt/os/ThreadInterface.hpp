@@ -42,6 +42,7 @@
 #include "fosi.h"
 #include "threads.hpp"
 #include "Time.hpp"
+#include "ThreadStatistics.hpp"
 #include "../rtt-config.h"
 
 namespace RTT
@@ -205,6 +206,19 @@ namespace RTT
              */
             virtual void yield() = 0;
 
+            /**
+             * Returns the scheduling statistics of this thread. This
+             * function does not block the thread.
+             * The default implementation returns empty statistics.
+             */
+            virtual ThreadStatistics getStatistics() const;
+
+            /**
+             * Clears the scheduling statistics of this thread. They
+             * are cleared by the thread itself before its next cycle.
+             */
+            virtual void resetStatistics();
+
             /**
              * The unique thread number (within the same process).
              */
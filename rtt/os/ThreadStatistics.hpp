@@ -0,0 +1,126 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  ThreadStatistics.hpp
+
+                        ThreadStatistics.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef OS_THREAD_STATISTICS_HPP
+#define OS_THREAD_STATISTICS_HPP
+
+#include "Time.hpp"
+#include <boost/array.hpp>
+
+namespace RTT
+{
+    namespace os
+    {
+        /**
+         * The scheduling statistics of a periodic thread, since it was
+         * started or since the statistics were last reset. All times are
+         * in seconds.
+         *
+         * The period jitter is the difference between the measured
+         * time between two wake-ups and the period. The wake-up latency
+         * is the time between the moment the thread should have woken up
+         * and the moment step() is called.
+         * @see ThreadInterface::getStatistics()
+         */
+        struct ThreadStatistics
+        {
+            /**
+             * The number of histogram buckets.
+             */
+            static const unsigned int JitterBuckets = 16;
+
+            ThreadStatistics() { reset(); }
+
+            /**
+             * The number of times step() was called.
+             */
+            unsigned int cycles;
+            /**
+             * The number of times step() took longer than the period.
+             */
+            unsigned int overruns;
+            /**
+             * The number of wake-ups of which the jitter
+             * and latency were measured.
+             */
+            unsigned int wakeups;
+            double step_min;
+            double step_max;
+            double step_mean;
+            double latency_min;
+            double latency_max;
+            double latency_mean;
+            /**
+             * The largest absolute period jitter.
+             */
+            double jitter_max;
+            /**
+             * Bucket \a i counts the cycles with an absolute period jitter
+             * below 2^i microseconds and not counted in bucket i-1, the last
+             * bucket counts all larger ones.
+             */
+            boost::array<unsigned int, JitterBuckets> jitter_histogram;
+
+            /**
+             * Clears all statistics.
+             */
+            void reset() {
+                cycles = 0;
+                overruns = 0;
+                wakeups = 0;
+                step_min = step_max = step_mean = 0.0;
+                latency_min = latency_max = latency_mean = 0.0;
+                jitter_max = 0.0;
+                jitter_histogram.assign(0);
+            }
+
+            /**
+             * Returns the histogram bucket of an absolute period jitter.
+             */
+            static unsigned int jitterBucket(nsecs jitter) {
+                unsigned int bucket = 0;
+                for (nsecs limit = 1000; bucket < JitterBuckets - 1 && jitter >= limit; limit *= 2)
+                    ++bucket;
+                return bucket;
+            }
+        };
+    }
+}
+
+#endif
@@ -71,11 +71,10 @@ namespace RTT {
                 // We can't use infinite as the OS may internally use time_spec, which can not
                 // represent as much in the future (until 2038) // XXX Year-2038 Bug
                 wake_up_time = (TimeService::InfiniteNSecs/4)-1;
-                for (TimerIds::iterator it = mtimers.begin(); it != mtimers.end(); ++it) {
-                    if ( it->first != 0 && it->first < wake_up_time  ) {
-                        wake_up_time = it->first;
-                        next_timer_id = it - mtimers.begin();
-                    }
+                // the first timer in the heap expires first.
+                if ( !mheap.empty() ) {
+                    next_timer_id = mheap.front();
+                    wake_up_time = mtimers[next_timer_id].first;
                 }
             }// MutexLock
 
@@ -98,10 +97,10 @@ namespace RTT {
                         TimerIds::iterator tim = mtimers.begin() + next_timer_id;
                         if ( tim->second ) {
                             // periodic timer
-                            tim->first += tim->second;
+                            setTimer( next_timer_id, tim->first + tim->second, tim->second );
                         } else {
                             // aperiodic timer
-                            tim->first = 0;
+                            clearTimer( next_timer_id );
                         }
                     }
                 }
@@ -121,10 +120,85 @@ namespace RTT {
         return true;
     }
 
+    void Timer::setTimer(TimerId timer_id, Time due_time, Time period)
+    {
+        mtimers[timer_id].first = due_time;
+        mtimers[timer_id].second = period;
+        int pos = mheap_pos[timer_id];
+        if ( pos == -1 ) {
+            pos = mheap.size();
+            mheap.push_back( timer_id );
+            mheap_pos[timer_id] = pos;
+        }
+        // the new expiry time may be earlier or later.
+        heapUp( pos );
+        heapDown( mheap_pos[timer_id] );
+    }
+
+    void Timer::clearTimer(TimerId timer_id)
+    {
+        mtimers[timer_id].first = 0;
+        mtimers[timer_id].second = 0;
+        int pos = mheap_pos[timer_id];
+        if ( pos == -1 )
+            return;
+        int last = mheap.size() - 1;
+        heapSwap( pos, last );
+        mheap.pop_back();
+        mheap_pos[timer_id] = -1;
+        if ( pos != last ) {
+            // the last timer moved to pos, restore the heap order.
+            TimerId moved = mheap[pos];
+            heapUp( pos );
+            heapDown( mheap_pos[moved] );
+        }
+    }
+
+    bool Timer::heapLess(int a, int b) const
+    {
+        Time ta = mtimers[ mheap[a] ].first;
+        Time tb = mtimers[ mheap[b] ].first;
+        // equal expiry times are served in timer id order.
+        return ta < tb || ( ta == tb && mheap[a] < mheap[b] );
+    }
+
+    void Timer::heapSwap(int a, int b)
+    {
+        std::swap( mheap[a], mheap[b] );
+        mheap_pos[ mheap[a] ] = a;
+        mheap_pos[ mheap[b] ] = b;
+    }
+
+    void Timer::heapUp(int pos)
+    {
+        while ( pos > 0 && heapLess( pos, (pos - 1) / 2 ) ) {
+            heapSwap( pos, (pos - 1) / 2 );
+            pos = (pos - 1) / 2;
+        }
+    }
+
+    void Timer::heapDown(int pos)
+    {
+        int size = mheap.size();
+        while ( true ) {
+            int child = 2 * pos + 1;
+            if ( child >= size )
+                return;
+            if ( child + 1 < size && heapLess( child + 1, child ) )
+                ++child;
+            if ( !heapLess( child, pos ) )
+                return;
+            heapSwap( pos, child );
+            pos = child;
+        }
+    }
+
     Timer::Timer(TimerId max_timers, int scheduler, int priority)
         : mThread(0), msem(0), mdo_quit(false)
     {
         mtimers.resize(max_timers);
+        mheap.reserve(max_timers);
+        mheap_pos.resize(max_timers, -1);
         if (scheduler != -1) {
             mThread = new Activity(scheduler, priority, 0.0, this, "Timer");
             mThread->start();
@@ -145,12 +219,16 @@ namespace RTT {
     void Timer::setMaxTimers(TimerId max)
     {
         MutexLock locker(m);
+        for (TimerId i = max; i < int(mtimers.size()); ++i)
+            clearTimer(i);
         mtimers.resize(max, std::make_pair(Time(0), Time(0)) );
+        mheap_pos.resize(max, -1);
+        mheap.reserve(max);
     }
 
     bool Timer::startTimer(TimerId timer_id, double period)
     {
-        if ( timer_id < 0 || timer_id > int(mtimers.size()) || period < 0.0)
+        if ( timer_id < 0 || timer_id >= int(mtimers.size()) || period < 0.0)
         {
             log(Error) << "Invalid timer id or period" << endlog();
             return false;
@@ -160,8 +238,9 @@ namespace RTT {
 
         {
             MutexLock locker(m);
-            mtimers[timer_id].first = due_time;
-            mtimers[timer_id].second = Seconds_to_nsecs( period );
+            if ( timer_id >= int(mtimers.size()) )
+                return false;
+            setTimer( timer_id, due_time, Seconds_to_nsecs( period ) );
         }
         msem.signal();
         return true;
@@ -169,7 +248,7 @@ namespace RTT {
 
     bool Timer::arm(TimerId timer_id, double wait_time)
     {
-        if ( timer_id < 0 || timer_id > int(mtimers.size()) || wait_time < 0.0)
+        if ( timer_id < 0 || timer_id >= int(mtimers.size()) || wait_time < 0.0)
         {
             log(Error) << "Invalid timer id or wait time" << endlog();
             return false;
@@ -180,8 +259,9 @@ namespace RTT {
 
         {
             MutexLock locker(m);
-            mtimers[timer_id].first  = due_time;
-            mtimers[timer_id].second = 0;
+            if ( timer_id >= int(mtimers.size()) )
+                return false;
+            setTimer( timer_id, due_time, 0 );
         }
         msem.signal();
         return true;
@@ -190,7 +270,7 @@ namespace RTT {
     bool Timer::isArmed(TimerId timer_id) const
     {
         MutexLock locker(m);
-        if (timer_id < 0 || timer_id > int(mtimers.size()) )
+        if (timer_id < 0 || timer_id >= int(mtimers.size()) )
         {
             log(Error) << "Invalid timer id" << endlog();
             return false;
@@ -201,7 +281,7 @@ namespace RTT {
     double Timer::timeRemaining(TimerId timer_id) const
     {
         MutexLock locker(m);
-        if (timer_id < 0 || timer_id > int(mtimers.size()) )
+        if (timer_id < 0 || timer_id >= int(mtimers.size()) )
         {
             log(Error) << "Invalid timer id" << endlog();
             return 0.0;
@@ -217,13 +297,12 @@ namespace RTT {
     bool Timer::killTimer(TimerId timer_id)
     {
         MutexLock locker(m);
-        if (timer_id < 0 || timer_id > int(mtimers.size()) )
+        if (timer_id < 0 || timer_id >= int(mtimers.size()) )
         {
             log(Error) << "Invalid timer id" << endlog();
             return false;
         }
-        mtimers[timer_id].first = 0;
-        mtimers[timer_id].second = 0;
+        clearTimer( timer_id );
         return true;
     }
 
@@ -83,6 +83,16 @@ namespace RTT
          */
         typedef std::vector<std::pair<Time, Time> > TimerIds;
         TimerIds mtimers;
+        /**
+         * The armed timers, as a binary min-heap ordered on
+         * their expiry time.
+         */
+        std::vector<TimerId> mheap;
+        /**
+         * Index in vector is the timer id, the value is the
+         * position of the timer in mheap or -1 if it is not armed.
+         */
+        std::vector<int> mheap_pos;
         bool mdo_quit;
 
         bool initialize();
@@ -94,6 +104,26 @@ namespace RTT
 
         bool breakLoop();
 
+        /**
+         * Sets the expiry time and period of \a timer_id
+         * and puts it at its place in mheap.
+         * @pre m is locked.
+         */
+        void setTimer(TimerId timer_id, Time due_time, Time period);
+        /**
+         * Disarms \a timer_id and removes it from mheap.
+         * @pre m is locked.
+         */
+        void clearTimer(TimerId timer_id);
+        /**
+         * Returns true if the timer at heap position \a a expires
+         * before the one at \a b.
+         */
+        bool heapLess(int a, int b) const;
+        void heapSwap(int a, int b);
+        void heapUp(int pos);
+        void heapDown(int pos);
+
     public:
         /**
          * Create a timer object which can hold \a max_timers timers.
@@ -110,6 +110,22 @@ extern "C"
 #endif
     }
 
+    /**
+     * Returns the time on the monotonic clock, which is not
+     * changed by setting the system time. Periodic threads
+     * are scheduled on this clock.
+     */
+    static inline NANO_TIME rtos_get_time_monotonic_ns( void )
+    {
+        TIME_SPEC tv;
+        clock_gettime(CLOCK_MONOTONIC, &tv);
+#ifdef __cplusplus
+        return NANO_TIME( tv.tv_sec ) * 1000000000LL + NANO_TIME( tv.tv_nsec );
+#else
+        return ( NANO_TIME ) ( tv.tv_sec * 1000000000LL ) + ( NANO_TIME ) ( tv.tv_nsec );
+#endif
+    }
+
     /**
      * This function should return ticks,
      * but we use ticks == nsecs in userspace
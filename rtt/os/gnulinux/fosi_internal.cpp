@@ -224,8 +224,9 @@ namespace RTT
 	{
 	    // set period
 	    mytask->period = nanosecs;
-	    // set next wake-up time.
-	    mytask->periodMark = ticks2timespec( nano2ticks( rtos_get_time_ns() + nanosecs ) );
+	    // set next wake-up time, on the monotonic clock such that
+	    // changing the system time does not disturb periodic threads.
+	    mytask->periodMark = ticks2timespec( nano2ticks( rtos_get_time_monotonic_ns() + nanosecs ) );
 	}
 
 	INTERNAL_QUAL void rtos_task_set_period( RTOS_TASK* mytask, NANO_TIME nanosecs )
@@ -244,11 +245,11 @@ namespace RTT
             return 0;
 
         // record this to detect overrun.
-	    NANO_TIME now = rtos_get_time_ns();
+	    NANO_TIME now = rtos_get_time_monotonic_ns();
 	    NANO_TIME wake= task->periodMark.tv_sec * 1000000000LL + task->periodMark.tv_nsec;
 
         // inspired by nanosleep man page for this construct:
-        while ( clock_nanosleep(CLOCK_REALTIME, TIMER_ABSTIME, &(task->periodMark), NULL) != 0 && errno == EINTR ) {
+        while ( clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &(task->periodMark), NULL) != 0 && errno == EINTR ) {
             errno = 0;
         }
 
@@ -265,7 +266,7 @@ namespace RTT
         else
         {
           TIME_SPEC ts = ticks2timespec( nano2ticks( task->period) );
-          TIME_SPEC now = ticks2timespec( rtos_get_time_ns() );
+          TIME_SPEC now = ticks2timespec( rtos_get_time_monotonic_ns() );
           NANO_TIME tn = (now.tv_nsec + ts.tv_nsec);
           task->periodMark.tv_nsec = tn % 1000000000LL;
           task->periodMark.tv_sec = ts.tv_sec + now.tv_sec + tn / 1000000000LL;
@@ -23,3 +23,24 @@
 #   error "Unsupported architecture or compiler"
 #  endif
 # endif
+
+#ifndef ORO_CACHELINE_SIZE
+/**
+ * The size of a cache line in bytes, used to keep data that is
+ * written by different threads on different cache lines.
+ */
+# define ORO_CACHELINE_SIZE 64
+#endif
+
+#ifndef oro_smp_mb
+/**
+ * A full memory barrier: loads and stores before it are not
+ * reordered with loads and stores after it, neither by the
+ * compiler nor by the processor.
+ */
+# if defined(_MSC_VER)
+#  define oro_smp_mb() MemoryBarrier()
+# elif defined(__GNUC__)
+#  define oro_smp_mb() __sync_synchronize()
+# endif
+#endif
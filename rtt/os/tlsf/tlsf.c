@@ -233,6 +233,24 @@ typedef struct TLSF_struct {
     u32_t sl_bitmap[REAL_FLI];
 
     bhdr_t *matrix[REAL_FLI][MAX_SLI];
+
+    /* Orocos: thread arena bookkeeping, see tlsf_arena_create() */
+    /* Total number of bytes handed to this pool */
+    size_t pool_size;
+    /* Non-zero if this pool is a thread arena */
+    int arena;
+    /* Set when the owning thread released the arena */
+    int volatile orphaned;
+    /* Number of threads currently pushing to remote_free */
+    int volatile pushing;
+    /* Blocks handed out by tlsf_malloc() and not yet returned */
+    long live;
+    /* Lock-free LIFO of blocks freed by other threads */
+    void * volatile remote_free;
+    /* Number of blocks freed by other threads */
+    unsigned long volatile remote_frees;
+    /* Link in the list of released, empty arenas */
+    struct TLSF_struct *next_arena;
 } tlsf_t;
 
 
@@ -448,36 +466,16 @@ static char *mp = NULL;         /* Default memory pool. */
 static int  init_check = 0;          /* Init detection */
 
 /******************************************************************/
-size_t init_memory_pool(size_t mem_pool_size, void *mem_pool)
+static size_t init_pool(size_t mem_pool_size, void *mem_pool)
 {
 /******************************************************************/
-    tlsf_t *tlsf;
+    tlsf_t *tlsf = (tlsf_t *) mem_pool;
     bhdr_t *b, *ib;
 
-    if (!mem_pool || !mem_pool_size || mem_pool_size < sizeof(tlsf_t) + BHDR_OVERHEAD * 8) {
-        ERROR_MSG("init_memory_pool (): memory_pool invalid\n");
-        return -1;
-    }
-
-    if (((unsigned long) mem_pool & PTR_MASK)) {
-        ERROR_MSG("init_memory_pool (): mem_pool must be aligned to a word\n");
-        return -1;
-    }
-    tlsf = (tlsf_t *) mem_pool;
-    /* Check if already initialised */
-    if (init_check) {
-        mp = mem_pool;
-        b = GET_NEXT_BLOCK(mp, ROUNDUP_SIZE(sizeof(tlsf_t)));
-        return b->size & BLOCK_SIZE;
-    }
-
-    mp = mem_pool;
-
     /* Zeroing the memory pool */
     memset(mem_pool, 0, sizeof(tlsf_t));
 
     tlsf->tlsf_signature = TLSF_SIGNATURE;
-    init_check = 1;
 
     TLSF_CREATE_LOCK(&tlsf->lock);
 
@@ -486,6 +484,7 @@ size_t init_memory_pool(size_t mem_pool_size, void *mem_pool)
     b = GET_NEXT_BLOCK(ib->ptr.buffer, ib->size & BLOCK_SIZE);
     free_ex(b->ptr.buffer, tlsf);
     tlsf->area_head = (area_info_t *) ib->ptr.buffer;
+    tlsf->pool_size = mem_pool_size;
 
 #if TLSF_STATISTIC
     tlsf->used_size = mem_pool_size - (b->size & BLOCK_SIZE);
@@ -495,6 +494,34 @@ size_t init_memory_pool(size_t mem_pool_size, void *mem_pool)
     return (b->size & BLOCK_SIZE);
 }
 
+/******************************************************************/
+size_t init_memory_pool(size_t mem_pool_size, void *mem_pool)
+{
+/******************************************************************/
+    bhdr_t *b;
+
+    if (!mem_pool || !mem_pool_size || mem_pool_size < sizeof(tlsf_t) + BHDR_OVERHEAD * 8) {
+        ERROR_MSG("init_memory_pool (): memory_pool invalid\n");
+        return -1;
+    }
+
+    if (((unsigned long) mem_pool & PTR_MASK)) {
+        ERROR_MSG("init_memory_pool (): mem_pool must be aligned to a word\n");
+        return -1;
+    }
+    /* Check if already initialised */
+    if (init_check) {
+        mp = mem_pool;
+        b = GET_NEXT_BLOCK(mp, ROUNDUP_SIZE(sizeof(tlsf_t)));
+        return b->size & BLOCK_SIZE;
+    }
+
+    mp = mem_pool;
+    init_check = 1;
+
+    return init_pool(mem_pool_size, mem_pool);
+}
+
 /******************************************************************/
 size_t add_new_area(void *area, size_t area_size, void *mem_pool)
 {
@@ -569,6 +596,7 @@ size_t add_new_area(void *area, size_t area_size, void *mem_pool)
     ai->next = tlsf->area_head;
     ai->end = lb0;
     tlsf->area_head = ai;
+    tlsf->pool_size += area_size;
     free_ex(b0->ptr.buffer, mem_pool);
     return (b0->size & BLOCK_SIZE);
 }
@@ -634,11 +662,33 @@ void destroy_memory_pool(void *mem_pool)
 
 
 /******************************************************************/
-void *tlsf_malloc(size_t size)
-{
+/*************** Orocos per-thread arenas *************************/
 /******************************************************************/
-    void *ret;
 
+/* Every block handed out by tlsf_malloc() is prefixed with the pool that
+ * owns it, such that tlsf_free() can return it to that pool from any
+ * thread. The prefix keeps the BLOCK_ALIGN alignment of the block. */
+#define OWNER_OVERHEAD  (BLOCK_ALIGN)
+#define BLOCK_OF(_p)    ((void *) ((char *) (_p) - OWNER_OVERHEAD))
+#define OWNER_OF(_p)    (*(tlsf_t **) BLOCK_OF(_p))
+#define USER_OF(_b)     ((void *) ((char *) (_b) + OWNER_OVERHEAD))
+
+#if defined(__GNUC__)
+#define TLSF_ARENAS     (1)
+/* The arena of the calling thread, if any */
+static __thread tlsf_t *thread_arena = NULL;
+/* Released arenas which are empty and can be handed out again */
+static tlsf_t *spare_arenas = NULL;
+static int volatile spare_lock = 0;
+#else
+#define TLSF_ARENAS     (0)
+#define thread_arena    ((tlsf_t *) NULL)
+#endif
+
+/******************************************************************/
+static int default_pool(void)
+{
+/******************************************************************/
 #if USE_MMAP || USE_SBRK
     if (!mp) {
         size_t area_size;
@@ -648,30 +698,149 @@ void *tlsf_malloc(size_t size)
         area_size = (area_size > DEFAULT_AREA_SIZE) ? area_size : DEFAULT_AREA_SIZE;
         area = get_new_area(&area_size);
         if (area == ((void *) ~0))
-            return NULL;        /* Not enough system memory */
+            return 0;           /* Not enough system memory */
         init_memory_pool(area_size, area);
     }
 #endif
+    return mp != NULL;
+}
+
+/******************************************************************/
+static __inline__ void *set_owner(void *b, tlsf_t *tlsf)
+{
+/******************************************************************/
+    if (!b)
+        return NULL;
+    *(tlsf_t **) b = tlsf;
+    return USER_OF(b);
+}
+
+#if TLSF_ARENAS
+/******************************************************************/
+static void drain_remote_frees(tlsf_t * tlsf)
+{
+/******************************************************************/
+    void **b, **next;
+
+    /* Taking the whole list at once makes the pop immune to ABA. */
+    b = (void **) __sync_lock_test_and_set(&tlsf->remote_free, NULL);
+    while (b) {
+        next = (void **) *b;
+        free_ex(b, tlsf);
+        --tlsf->live;
+        b = next;
+    }
+}
+
+/******************************************************************/
+static void free_orphaned(tlsf_t * tlsf, void *b)
+{
+/******************************************************************/
+    int empty;
+
+    TLSF_ACQUIRE_LOCK(&tlsf->lock);
+    if (b) {
+        free_ex(b, tlsf);
+        --tlsf->live;
+    }
+    drain_remote_frees(tlsf);
+    empty = (tlsf->live == 0);
+    TLSF_RELEASE_LOCK(&tlsf->lock);
+
+    /* Nobody holds a block of this arena any more, so nobody can touch
+     * it again: make it available to tlsf_arena_create(). */
+    if (empty) {
+        while (__sync_lock_test_and_set(&spare_lock, 1))
+            ;
+        tlsf->next_arena = spare_arenas;
+        spare_arenas = tlsf;
+        __sync_lock_release(&spare_lock);
+    }
+}
+
+/******************************************************************/
+static void free_remote(tlsf_t * tlsf, void *b)
+{
+/******************************************************************/
+    void *head;
+
+    /* The pushing count lets tlsf_arena_release() wait until no thread
+     * can still add a block to the list it is about to drain. */
+    __sync_fetch_and_add(&tlsf->pushing, 1);
+    if (!tlsf->orphaned) {
+        do {
+            head = tlsf->remote_free;
+            *(void **) b = head;
+        } while (!__sync_bool_compare_and_swap(&tlsf->remote_free, head, b));
+        __sync_fetch_and_add(&tlsf->remote_frees, 1);
+        __sync_fetch_and_sub(&tlsf->pushing, 1);
+        return;
+    }
+    __sync_fetch_and_sub(&tlsf->pushing, 1);
+    free_orphaned(tlsf, b);
+}
+#endif
+
+/******************************************************************/
+void *tlsf_malloc(size_t size)
+{
+/******************************************************************/
+    void *ret;
+
+#if TLSF_ARENAS
+    tlsf_t *arena = thread_arena;
+
+    if (arena) {
+        if (arena->remote_free)
+            drain_remote_frees(arena);
+        ret = malloc_ex(size + OWNER_OVERHEAD, arena);
+        if (ret) {
+            ++arena->live;
+            return set_owner(ret, arena);
+        }
+        /* The arena is exhausted: fall back to the default pool. */
+    }
+#endif
+
+    if (!default_pool())
+        return NULL;
 
     TLSF_ACQUIRE_LOCK(&((tlsf_t *)mp)->lock);
 
-    ret = malloc_ex(size, mp);
+    ret = malloc_ex(size + OWNER_OVERHEAD, mp);
 
     TLSF_RELEASE_LOCK(&((tlsf_t *)mp)->lock);
 
-    return ret;
+    return set_owner(ret, (tlsf_t *) mp);
 }
 
 /******************************************************************/
 void tlsf_free(void *ptr)
 {
 /******************************************************************/
+    tlsf_t *owner;
 
-    TLSF_ACQUIRE_LOCK(&((tlsf_t *)mp)->lock);
+    if (!ptr)
+        return;
+    owner = OWNER_OF(ptr);
 
-    free_ex(ptr, mp);
+#if TLSF_ARENAS
+    if (owner == thread_arena) {
+        free_ex(BLOCK_OF(ptr), owner);
+        --owner->live;
+        return;
+    }
+    if (owner->arena) {
+        free_remote(owner, BLOCK_OF(ptr));
+        return;
+    }
+#endif
 
-    TLSF_RELEASE_LOCK(&((tlsf_t *)mp)->lock);
+    TLSF_ACQUIRE_LOCK(&owner->lock);
+
+    free_ex(BLOCK_OF(ptr), owner);
+
+    TLSF_RELEASE_LOCK(&owner->lock);
 
 }
 
@@ -680,19 +849,37 @@ void *tlsf_realloc(void *ptr, size_t size)
 {
 /******************************************************************/
     void *ret;
+    tlsf_t *owner;
+    size_t usable;
 
-#if USE_MMAP || USE_SBRK
-	if (!mp) {
-		return tlsf_malloc(size);
-	}
-#endif
+    if (!ptr)
+        return tlsf_malloc(size);
+    if (!size) {
+        tlsf_free(ptr);
+        return NULL;
+    }
+    owner = OWNER_OF(ptr);
 
-    TLSF_ACQUIRE_LOCK(&((tlsf_t *)mp)->lock);
+    if (!owner->arena) {
+        TLSF_ACQUIRE_LOCK(&owner->lock);
 
-    ret = realloc_ex(ptr, size, mp);
+        ret = realloc_ex(BLOCK_OF(ptr), size + OWNER_OVERHEAD, owner);
 
-    TLSF_RELEASE_LOCK(&((tlsf_t *)mp)->lock);
+        TLSF_RELEASE_LOCK(&owner->lock);
 
+        return ret ? USER_OF(ret) : NULL;
+    }
+
+    /* Arena blocks only shrink in place, since the owner of the arena
+     * may be another thread. */
+    usable = (((bhdr_t *) ((char *) BLOCK_OF(ptr) - BHDR_OVERHEAD))->size & BLOCK_SIZE) - OWNER_OVERHEAD;
+    if (size <= usable)
+        return ptr;
+    ret = tlsf_malloc(size);
+    if (!ret)
+        return NULL;
+    memcpy(ret, ptr, usable);
+    tlsf_free(ptr);
     return ret;
 }
 
@@ -702,13 +889,146 @@ void *tlsf_calloc(size_t nelem, size_t elem_size)
 /******************************************************************/
     void *ret;
 
+    if (nelem <= 0 || elem_size <= 0)
+        return NULL;
+
+    ret = tlsf_malloc(nelem * elem_size);
+    if (ret)
+        memset(ret, 0, nelem * elem_size);
+
+    return ret;
+}
+
+/******************************************************************/
+void *tlsf_arena_create(size_t size)
+{
+/******************************************************************/
+#if TLSF_ARENAS
+    tlsf_t *tlsf, **prev;
+    void *area;
+
+    size = (size > DEFAULT_AREA_SIZE) ? size : DEFAULT_AREA_SIZE;
+    size = ROUNDUP_SIZE(size + sizeof(tlsf_t));
+
+    /* Reuse an arena released by an exited thread first */
+    while (__sync_lock_test_and_set(&spare_lock, 1))
+        ;
+    for (prev = &spare_arenas; *prev; prev = &(*prev)->next_arena)
+        if ((*prev)->pool_size >= size)
+            break;
+    tlsf = *prev;
+    if (tlsf)
+        *prev = tlsf->next_arena;
+    __sync_lock_release(&spare_lock);
+
+    if (tlsf) {
+        tlsf->next_arena = NULL;
+        tlsf->remote_frees = 0;
+#if TLSF_STATISTIC
+        tlsf->max_size = tlsf->used_size;
+#endif
+        __sync_lock_test_and_set(&tlsf->orphaned, 0);
+        return tlsf;
+    }
+
+    /* The arena itself is carved out of the default pool and is never
+     * returned to it. */
+    if (!default_pool())
+        return NULL;
+
     TLSF_ACQUIRE_LOCK(&((tlsf_t *)mp)->lock);
 
-    ret = calloc_ex(nelem, elem_size, mp);
+    area = malloc_ex(size, mp);
 
     TLSF_RELEASE_LOCK(&((tlsf_t *)mp)->lock);
 
-    return ret;
+    if (!area)
+        return NULL;
+    init_pool(size, area);
+    ((tlsf_t *) area)->arena = 1;
+    return area;
+#else
+    return NULL;
+#endif
+}
+
+/******************************************************************/
+void *tlsf_arena_attach(void *arena)
+{
+/******************************************************************/
+#if TLSF_ARENAS
+    tlsf_t *prev = thread_arena;
+
+    thread_arena = (tlsf_t *) arena;
+    return prev;
+#else
+    return NULL;
+#endif
+}
+
+/******************************************************************/
+void *tlsf_arena_current(void)
+{
+/******************************************************************/
+    return thread_arena;
+}
+
+/******************************************************************/
+void tlsf_arena_release(void *arena)
+{
+/******************************************************************/
+#if TLSF_ARENAS
+    tlsf_t *tlsf = (tlsf_t *) arena;
+    TIME_SPEC ts;
+
+    if (!tlsf || !tlsf->arena)
+        return;
+    if (thread_arena == tlsf)
+        thread_arena = NULL;
+
+    /* From now on, other threads free their blocks under the arena lock
+     * instead of pushing them to the remote free list. */
+    __sync_bool_compare_and_swap(&tlsf->orphaned, 0, 1);
+    ts.tv_sec = 0;
+    ts.tv_nsec = 10000;
+    while (tlsf->pushing)
+        rtos_nanosleep(&ts, NULL);
+
+    free_orphaned(tlsf, NULL);
+#endif
+}
+
+/******************************************************************/
+int tlsf_arena_stats(void *mem_pool, struct tlsf_stats *stats)
+{
+/******************************************************************/
+    tlsf_t *tlsf = (tlsf_t *) (mem_pool ? mem_pool : mp);
+    int fl, sl;
+
+    if (!stats)
+        return -1;
+    memset(stats, 0, sizeof(struct tlsf_stats));
+    if (!tlsf)
+        return -1;
+
+    stats->size = tlsf->pool_size;
+#if TLSF_STATISTIC
+    stats->used = tlsf->used_size;
+    stats->max_used = tlsf->max_size;
+#endif
+    /* The lower bound of the largest non-empty size class is a good enough
+     * estimate and does not need to look at the blocks themselves. */
+    if (tlsf->fl_bitmap) {
+        fl = ms_bit(tlsf->fl_bitmap);
+        sl = ms_bit(tlsf->sl_bitmap[fl]);
+        if (fl == 0)
+            stats->largest_free = sl * (SMALL_BLOCK / MAX_SLI);
+        else
+            stats->largest_free = ((size_t) 1 << (fl + FLI_OFFSET)) + ((size_t) sl << (fl + FLI_OFFSET - MAX_LOG2_SLI));
+    }
+    stats->remote_frees = tlsf->remote_frees;
+    stats->arena = tlsf->arena;
+    return 0;
 }
 
 /******************************************************************/
@@ -27,6 +27,11 @@
 #define tlsf_free oro_rt_free
 #define tlsf_realloc oro_rt_realloc
 #define tlsf_calloc oro_rt_calloc
+#define tlsf_arena_create oro_rt_arena_create
+#define tlsf_arena_attach oro_rt_arena_attach
+#define tlsf_arena_current oro_rt_arena_current
+#define tlsf_arena_release oro_rt_arena_release
+#define tlsf_arena_stats oro_rt_arena_stats
 
 #ifdef	__cplusplus
 extern "C" {
@@ -51,6 +56,28 @@ extern void tlsf_free(void *ptr);
 extern void *tlsf_realloc(void *ptr, size_t size);
 extern void *tlsf_calloc(size_t nelem, size_t elem_size);
 
+/*
+ * Orocos per-thread arenas: a thread which attached an arena allocates
+ * from it with tlsf_malloc() without taking any lock. Blocks freed by
+ * other threads are queued lock-free and returned by the owner on its
+ * next allocation. A released arena stays alive until its last block
+ * is freed, after which it is reused by tlsf_arena_create().
+ */
+struct tlsf_stats {
+    size_t size;                /* bytes managed by the pool */
+    size_t used;                /* bytes in use, including overhead */
+    size_t max_used;            /* peak of used */
+    size_t largest_free;        /* lower bound of the largest free block */
+    unsigned long remote_frees; /* blocks freed by other threads */
+    int arena;                  /* non-zero for a thread arena */
+};
+
+extern void *tlsf_arena_create(size_t size);
+extern void *tlsf_arena_attach(void *arena);
+extern void *tlsf_arena_current(void);
+extern void tlsf_arena_release(void *arena);
+extern int tlsf_arena_stats(void *arena, struct tlsf_stats *stats);
+
 #ifdef	__cplusplus
 }
 #endif
@@ -51,12 +51,24 @@
 #include "../os/StartStopManager.hpp"
 #include "../os/MutexLock.hpp"
 #include "../internal/GlobalService.hpp"
+#include "../types/TypeInfoRepository.hpp"
+#include <boost/bind.hpp>
 
 #include <cstdlib>
+#include <cstdio>
 #include <dlfcn.h>
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
 
 #include <vector>
 #include <set>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 
 using namespace RTT;
 using namespace RTT::detail;
@@ -256,6 +268,30 @@ static string makeShortFilename(string const& str) {
     return ret;
 }
 
+/**
+ * The first line of a plugin cache file. Caches written by other
+ * RTT versions or for other targets are not used.
+ */
+static string cacheHeader() {
+    ostringstream header;
+    header << "# RTT plugin cache " << RTT_VERSION_MAJOR << "." << RTT_VERSION_MINOR << " " << OROCOS_TARGET_NAME;
+    return header.str();
+}
+
+/**
+ * Splits a line of the plugin cache in its tab separated fields.
+ */
+static vector<string> splitFields(string const& line) {
+    vector<string> fields;
+    string::size_type start = 0, pos;
+    while ( (pos = line.find('\t', start)) != string::npos ) {
+        fields.push_back( line.substr(start, pos - start) );
+        start = pos + 1;
+    }
+    fields.push_back( line.substr(start) );
+    return fields;
+}
+
 }
 
 static RTT_UNUSED bool hasEnding(string const &fullString, string const &ending)
@@ -295,6 +331,11 @@ namespace {
         }
         // we set the plugin path such that we can search for sub-directories/projects lateron
         PluginLoader::Instance()->setPluginPath(plugin_paths);
+        char* cache = getenv("RTT_PLUGIN_CACHE");
+        if (cache && *cache) {
+            log(Info) <<"RTT_PLUGIN_CACHE was set to: " << cache <<endlog();
+            PluginLoader::Instance()->setPluginCache(cache);
+        }
         // we load the plugins/typekits which are in each plugin path directory (but not subdirectories).
         try {
             PluginLoader::Instance()->loadPlugin("rtt", plugin_paths);
@@ -303,6 +344,9 @@ namespace {
             log(Warning) << e.what() <<endlog();
             log(Warning) << "Corrupted files found in '" << plugin_paths << "'. Fix or remove these plugins."<<endlog();
         }
+        // the RTT's own typekit is never deferred.
+        if ( getenv("RTT_LAZY_TYPEKITS") )
+            PluginLoader::Instance()->setLazyTypekits(true);
         return 0;
     }
 
@@ -318,8 +362,8 @@ namespace {
 
 static boost::shared_ptr<PluginLoader> instance2;
 
-PluginLoader::PluginLoader() { log(Debug) <<"PluginLoader Created" <<endlog(); }
-PluginLoader::~PluginLoader(){ log(Debug) <<"PluginLoader Destroyed" <<endlog(); }
+PluginLoader::PluginLoader() : cache_dirty(false), lazy_typekits(false) { log(Debug) <<"PluginLoader Created" <<endlog(); }
+PluginLoader::~PluginLoader(){ writeCache(); log(Debug) <<"PluginLoader Destroyed" <<endlog(); }
 
 
 boost::shared_ptr<PluginLoader> PluginLoader::Instance() {
@@ -441,6 +485,8 @@ bool PluginLoader::loadPluginsInternal( std::string const& path_list, std::strin
                     else
                     {
                         found = true;
+                        if ( lazy_typekits && kind == "typekit" && deferTypekit( itr->path().string(), makeShortFilename(libname) ) )
+                            continue;
                         all_good = loadInProcess( itr->path().string(), makeShortFilename(libname), kind, true) && all_good;
                     }
                 } else {
@@ -454,6 +500,7 @@ bool PluginLoader::loadPluginsInternal( std::string const& path_list, std::strin
         else
             log(Debug) << "No such directory: " << p << endlog();
     }
+    writeCache();
     if (!all_good)
         throw std::runtime_error("Some found plugins could not be loaded !");
     return found;
@@ -635,6 +682,12 @@ bool PluginLoader::isLoadedInternal(string file)
         }
         ++lib;
     }
+    // deferred typekits are loaded as soon as they are needed:
+    for (lib = deferredLibs.begin(); lib != deferredLibs.end(); ++lib) {
+        if ( lib->filename == p.filename() || lib->plugname == file || lib->shortname == file ) {
+            return true;
+        }
+    }
     return false;
 }
 
@@ -657,6 +710,20 @@ bool PluginLoader::loadInProcess(string file, string shortname, string kind, boo
         return false;
     }
 
+    CacheEntry entry;
+    entry.kind = kind;
+    CacheEntry* cached = findCacheEntry( p.string() );
+    if ( cached && !cached->is_plugin ) {
+        if (log_error)
+            log(Error) <<"Not a plugin: '" << p.string() << "' (cached)." << endlog();
+        return false;
+    }
+
+    // remember the types known before, to learn which ones this typekit adds:
+    vector<string> known_types;
+    if ( !cache_file.empty() && kind == "typekit" )
+        known_types = types::TypeInfoRepository::Instance()->getTypes();
+
     handle = dlopen ( p.string().c_str(), RTLD_NOW | RTLD_GLOBAL );
 
     if (!handle) {
@@ -700,6 +767,7 @@ bool PluginLoader::loadInProcess(string file, string shortname, string kind, boo
             log(Error) << "Plugin "<< plugname <<" reports to be compiled for OROCOS_TARGET "<< targetname
                     << " while we are running on target "<< OROCOS_TARGET_NAME <<". Unloading."<<endlog();
             dlclose(handle);
+            updateCache( p.string(), entry );
             return false;
         }
 
@@ -737,15 +805,173 @@ bool PluginLoader::loadInProcess(string file, string shortname, string kind, boo
             }
         }
         loadedLibs.push_back(loading_lib);
+
+        entry.is_plugin = true;
+        entry.plugname = plugname;
+        if ( !cache_file.empty() && kind == "typekit" ) {
+            types::TypeInfoRepository::shared_ptr ti = types::TypeInfoRepository::Instance();
+            vector<string> now = ti->getTypes();
+            sort( known_types.begin(), known_types.end() );
+            for(vector<string>::iterator it = now.begin(); it != now.end(); ++it) {
+                if ( binary_search( known_types.begin(), known_types.end(), *it ) )
+                    continue;
+                types::TypeInfo* t = ti->type( *it );
+                entry.types.push_back( *it );
+                entry.type_ids.push_back( t && t->getTypeId() ? t->getTypeId()->name() : "" );
+            }
+        }
+        updateCache( p.string(), entry );
         return true;
     } else {
         if (log_error)
             log(Error) <<"Not a plugin: " << error << endlog();
+        updateCache( p.string(), entry );
     }
     dlclose(handle);
     return false;
 }
 
+bool PluginLoader::deferTypekit(std::string const& file, std::string const& shortname)
+{
+    CacheEntry* entry = findCacheEntry( file );
+    if ( !entry || !entry->is_plugin || entry->kind != "typekit" || entry->types.empty() )
+        return false;
+    if ( isLoadedInternal(shortname) || isLoadedInternal(file) )
+        return false;
+    if ( !types::TypeInfoRepository::Instance()->addDeferredTypes( entry->types, entry->type_ids, boost::bind( &PluginLoader::loadDeferred, file, shortname ) ) )
+        return false;
+
+    path p(file);
+#if BOOST_VERSION >= 104600
+    LoadedLib deferred_lib( p.filename().string(), shortname, 0 );
+#else
+    LoadedLib deferred_lib( p.filename(), shortname, 0 );
+#endif
+    deferred_lib.plugname = entry->plugname;
+    deferred_lib.is_typekit = true;
+    deferredLibs.push_back( deferred_lib );
+    log(Info) << "Deferred RTT TypeKit '" + entry->plugname + "' from '" + shortname +"' until its types are used."<<endlog();
+    return true;
+}
+
+bool PluginLoader::loadDeferred(std::string file, std::string shortname)
+{
+    PluginLoader::shared_ptr pl = Instance();
+    MutexLock lock( pl->listlock );
+    path p(file);
+    for(vector<LoadedLib>::iterator it = pl->deferredLibs.begin(); it != pl->deferredLibs.end(); ++it) {
+        if ( it->filename == p.filename() ) {
+            pl->deferredLibs.erase( it );
+            break;
+        }
+    }
+    bool result = pl->loadInProcess( file, shortname, "typekit", true );
+    pl->writeCache();
+    return result;
+}
+
+PluginLoader::CacheEntry* PluginLoader::findCacheEntry(std::string const& file)
+{
+    if ( cache_file.empty() )
+        return 0;
+    Cache::iterator it = cache.find( file );
+    if ( it == cache.end() )
+        return 0;
+    try {
+        if ( last_write_time( path(file) ) == it->second.mtime && file_size( path(file) ) == it->second.size )
+            return &it->second;
+    } catch (filesystem_error& ) {
+    }
+    log(Debug) << "Plugin cache entry of '" << file << "' is outdated." << endlog();
+    cache.erase( it );
+    cache_dirty = true;
+    return 0;
+}
+
+void PluginLoader::updateCache(std::string const& file, CacheEntry const& entry)
+{
+    if ( cache_file.empty() )
+        return;
+    CacheEntry& stored = cache[file];
+    stored = entry;
+    try {
+        stored.mtime = last_write_time( path(file) );
+        stored.size = file_size( path(file) );
+    } catch (filesystem_error& ) {
+        cache.erase( file );
+        return;
+    }
+    cache_dirty = true;
+}
+
+void PluginLoader::readCache()
+{
+    cache.clear();
+    cache_dirty = false;
+    std::ifstream in( cache_file.c_str() );
+    if ( !in ) {
+        log(Info) << "Plugin cache '" << cache_file << "' does not exist yet." << endlog();
+        return;
+    }
+    string line;
+    if ( !getline(in, line) || line != cacheHeader() ) {
+        log(Info) << "Plugin cache '" << cache_file << "' was written by another RTT version or target: discarding it." << endlog();
+        cache_dirty = true;
+        return;
+    }
+    // Each library is one 'L' line, followed by one 'T' line per type it registered.
+    CacheEntry* entry = 0;
+    while ( getline(in, line) ) {
+        vector<string> fields = splitFields( line );
+        if ( fields[0] == "L" && fields.size() == 7 ) {
+            entry = &cache[ fields[1] ];
+            istringstream( fields[2] ) >> entry->mtime;
+            istringstream( fields[3] ) >> entry->size;
+            entry->kind = fields[4];
+            entry->is_plugin = fields[5] == "1";
+            entry->plugname = fields[6];
+        } else if ( fields[0] == "T" && fields.size() == 3 && entry ) {
+            entry->types.push_back( fields[1] );
+            entry->type_ids.push_back( fields[2] );
+        } else {
+            entry = 0;
+        }
+    }
+    log(Debug) << "Read " << cache.size() << " entries from plugin cache '" << cache_file << "'." << endlog();
+}
+
+void PluginLoader::writeCache()
+{
+    if ( cache_file.empty() || !cache_dirty )
+        return;
+    // write a private file first, such that concurrent processes never read a partial cache.
+    ostringstream tmpname;
+    tmpname << cache_file << "." << getpid();
+    {
+        std::ofstream out( tmpname.str().c_str() );
+        out << cacheHeader() << '\n';
+        for(Cache::const_iterator it = cache.begin(); it != cache.end(); ++it) {
+            const CacheEntry& e = it->second;
+            out << "L\t" << it->first << '\t' << e.mtime << '\t' << e.size << '\t' << e.kind
+                << '\t' << (e.is_plugin ? "1" : "0") << '\t' << e.plugname << '\n';
+            for(unsigned int i = 0; i != e.types.size(); ++i)
+                out << "T\t" << e.types[i] << '\t' << e.type_ids[i] << '\n';
+        }
+        out.flush();
+        if ( !out ) {
+            log(Warning) << "Could not write plugin cache '" << tmpname.str() << "'." << endlog();
+            std::remove( tmpname.str().c_str() );
+            return;
+        }
+    }
+    if ( std::rename( tmpname.str().c_str(), cache_file.c_str() ) != 0 ) {
+        log(Warning) << "Could not replace plugin cache '" << cache_file << "'." << endlog();
+        std::remove( tmpname.str().c_str() );
+        return;
+    }
+    cache_dirty = false;
+}
+
 std::vector<std::string> PluginLoader::listServices() const {
     MutexLock lock( listlock );
     vector<string> names;
@@ -762,6 +988,9 @@ std::vector<std::string> PluginLoader::listPlugins() const {
     for(vector<LoadedLib>::const_iterator it= loadedLibs.begin(); it != loadedLibs.end(); ++it) {
         names.push_back( it->plugname );
     }
+    for(vector<LoadedLib>::const_iterator it= deferredLibs.begin(); it != deferredLibs.end(); ++it) {
+        names.push_back( it->plugname );
+    }
     return names;
 }
 
@@ -772,6 +1001,9 @@ std::vector<std::string> PluginLoader::listTypekits() const {
         if ( it->is_typekit )
             names.push_back( it->plugname );
     }
+    for(vector<LoadedLib>::const_iterator it= deferredLibs.begin(); it != deferredLibs.end(); ++it) {
+        names.push_back( it->plugname );
+    }
     return names;
 }
 
@@ -785,6 +1017,26 @@ void PluginLoader::setPluginPath( std::string const& newpath ) {
     plugin_path = newpath;
 }
 
+void PluginLoader::setPluginCache( std::string const& file ) {
+    MutexLock lock( listlock );
+    writeCache();
+    cache_file = file;
+    if ( cache_file.empty() )
+        cache.clear();
+    else
+        readCache();
+}
+
+std::string PluginLoader::getPluginCache() const {
+    MutexLock lock( listlock );
+    return cache_file;
+}
+
+void PluginLoader::setLazyTypekits( bool lazy ) {
+    MutexLock lock( listlock );
+    lazy_typekits = lazy;
+}
+
 bool PluginLoader::isCompatiblePlugin(std::string const& filepath)
 {
     path p(filepath);
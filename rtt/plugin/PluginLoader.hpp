@@ -41,7 +41,10 @@
 
 #include <string>
 #include <vector>
+#include <map>
+#include <ctime>
 #include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
 
 #include "../rtt-fwd.hpp"
 #include "../rtt-config.h"
@@ -63,6 +66,19 @@ namespace RTT {
          *
          * If neither is specified, it looks for plugins in the current directory (".").
          *
+         * @section cache Plugin Cache
+         * When a cache file is set with setPluginCache(), or with the RTT_PLUGIN_CACHE
+         * variable at startup, the PluginLoader remembers for each library it
+         * probed its modification time, size, kind, plugin name and the types it
+         * registered. Libraries which did not change and which are known not
+         * to be plugins are then skipped without opening them.
+         *
+         * With setLazyTypekits(true), or RTT_LAZY_TYPEKITS at startup, typekits
+         * found in a directory scan whose types are known from the cache are not loaded,
+         * but announced to the TypeInfoRepository and loaded the first time one of
+         * their types is looked up. Typekits which register no types, like transports,
+         * and libraries loaded by file name are always loaded immediately.
+         *
          * @see Plugin.hpp
          */
         class RTT_API PluginLoader
@@ -97,6 +113,37 @@ namespace RTT {
 
             std::vector< LoadedLib > loadedLibs;
 
+            /**
+             * Typekits found in a scan, of which the loading is
+             * postponed until one of their types is used.
+             */
+            std::vector< LoadedLib > deferredLibs;
+
+            /**
+             * What the plugin cache remembers of a probed library.
+             */
+            struct CacheEntry {
+                CacheEntry() : mtime(0), size(0), is_plugin(false) {}
+                std::time_t mtime;
+                boost::uintmax_t size;
+                std::string kind;
+                /**
+                 * False if the library was found not to be an RTT plugin
+                 * for this target.
+                 */
+                bool is_plugin;
+                std::string plugname;
+                /**
+                 * The type names and type id names a typekit registered.
+                 */
+                std::vector<std::string> types, type_ids;
+            };
+            typedef std::map<std::string, CacheEntry> Cache;
+            Cache cache;
+            std::string cache_file;
+            bool cache_dirty;
+            bool lazy_typekits;
+
             /**
              * Path to look for if all else fails.
              */
@@ -150,6 +197,29 @@ namespace RTT {
              */
             bool isCompatiblePlugin(std::string const& filepath);
 
+            /**
+             * Returns the cache entry of \a file if it is still valid
+             * for the file on disk, or null.
+             */
+            CacheEntry* findCacheEntry(std::string const& file);
+            /**
+             * Stores what was learned about \a file in the cache.
+             */
+            void updateCache(std::string const& file, CacheEntry const& entry);
+            void readCache();
+            void writeCache();
+            /**
+             * Announces the types of a cached typekit to the type system
+             * instead of loading it.
+             * @return false if the typekit must be loaded now.
+             */
+            bool deferTypekit(std::string const& file, std::string const& shortname);
+            /**
+             * Loads a typekit postponed by deferTypekit(). Called by the
+             * TypeInfoRepository.
+             */
+            static bool loadDeferred(std::string file, std::string shortname);
+
         public:
             PluginLoader();
             ~PluginLoader();
@@ -265,6 +335,26 @@ namespace RTT {
              * @param newpath The new paths to look for plugins.
              */
             void setPluginPath( std::string const& newpath );
+
+            /**
+             * Sets the file in which the plugin cache is kept and reads it.
+             * The file is written back after each directory scan that
+             * probed new libraries. This is typically done by RTT startup
+             * code with the contents of the RTT_PLUGIN_CACHE variable.
+             * @param file A file name or the empty string to disable the cache.
+             */
+            void setPluginCache( std::string const& file );
+
+            /**
+             * Returns the file set by setPluginCache().
+             */
+            std::string getPluginCache() const;
+
+            /**
+             * Enables or disables postponing the loading of cached typekits
+             * until their types are used. Disabled by default.
+             */
+            void setLazyTypekits( bool lazy );
         };
     }
 }
@@ -55,6 +55,7 @@ namespace RTT
     class Alias;
     class CleanupHandle;
     class ConnPolicy;
+    struct ConnectionStatistics;
     class ExecutionEngine;
     class Handle;
     class Logger;
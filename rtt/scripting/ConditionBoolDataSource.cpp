@@ -35,6 +35,7 @@
  *                                                                         *
  ***************************************************************************/
 #include "ConditionBoolDataSource.hpp"
+#include "../internal/DataSources.hpp"
 
 namespace RTT {
     using namespace detail;
@@ -53,6 +54,11 @@ namespace RTT {
     return new ConditionBoolDataSource( data.get() );
   }
 
+  bool ConditionBoolDataSource::isConstant() const
+  {
+    return dynamic_cast<ConstantDataSource<bool>*>( data.get() ) != 0;
+  }
+
   void ConditionBoolDataSource::reset()
   {
     data->reset();
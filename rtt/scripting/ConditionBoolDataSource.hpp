@@ -69,6 +69,10 @@ namespace RTT
     ConditionBoolDataSource* clone() const;
     void reset();
     ConditionBoolDataSource* copy( std::map<const base::DataSourceBase*, base::DataSourceBase*>& alreadyCloned ) const;
+    /**
+     * Returns true if the internal::DataSource is a constant.
+     */
+    bool isConstant() const;
   };
 }};
 
@@ -65,6 +65,11 @@ namespace RTT
                 return false;
             }
 
+            virtual bool isConstant() const
+            {
+                return true;
+            }
+
             virtual ConditionInterface* clone() const
             {
                 return new ConditionFalse;
@@ -47,6 +47,10 @@ namespace RTT {
     void ConditionInterface::reset() {
     }
 
+    bool ConditionInterface::isConstant() const {
+        return false;
+    }
+
     ConditionInterface* ConditionInterface::copy( std::map<const DataSourceBase*, DataSourceBase*>& ) const {
         return clone();
     }
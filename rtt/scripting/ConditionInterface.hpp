@@ -80,6 +80,14 @@ namespace RTT
          */
         virtual void reset();
 
+        /**
+         * Returns true if this condition always evaluates to the
+         * same value and has no side effects, such that it may be
+         * evaluated once when a program or state machine is loaded.
+         * The default implementation returns false.
+         */
+        virtual bool isConstant() const;
+
         /**
          * The Clone Software Pattern.
          */
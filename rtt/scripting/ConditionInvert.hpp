@@ -69,6 +69,11 @@ namespace RTT
             return ! mc->evaluate();
         }
 
+        virtual bool isConstant() const
+        {
+            return mc->isConstant();
+        }
+
         virtual ConditionInterface* copy( std::map<const base::DataSourceBase*, base::DataSourceBase*>& alreadyCloned ) const
         {
             return new ConditionInvert( mc->copy(alreadyCloned) );
@@ -65,6 +65,11 @@ namespace RTT
                 return true;
             }
 
+            virtual bool isConstant() const
+            {
+                return true;
+            }
+
             virtual ConditionInterface* clone() const
             {
                 return new ConditionTrue;
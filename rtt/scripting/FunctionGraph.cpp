@@ -57,7 +57,8 @@ namespace RTT {
 
 
     FunctionGraph::FunctionGraph(const std::string& _name, bool unload_on_stop)
-        : myName(_name), retn(0), pausing(false), mstep(false), munload_on_stop(unload_on_stop)
+        : current(0), previous(0), startpc(0), exitpc(0),
+          myName(_name), retn(0), pausing(false), mstep(false), munload_on_stop(unload_on_stop)
     {
         // the start vertex of our function graph
         startv = add_vertex( program );
@@ -67,7 +68,8 @@ namespace RTT {
     }
 
     FunctionGraph::FunctionGraph( const FunctionGraph& orig )
-        :  program( orig.getGraph() ), myName( orig.getName() )
+        :  current(0), previous(0), startpc(0), exitpc(0),
+           program( orig.getGraph() ), myName( orig.getName() )
     {
         // The nodes are copied, which causes a clone of their contents.
         graph_traits<Graph>::vertex_iterator v1,v2, it;
@@ -108,9 +110,75 @@ namespace RTT {
         graph_traits<Graph>::vertices_size_type cnt = 0;
         for(tie(vi,vend) = vertices(program); vi != vend; ++vi)
             put(index, *vi, cnt++);
+        this->compile();
         this->reset();
     }
 
+    void FunctionGraph::compile()
+    {
+        property_map<Graph, vertex_index_t>::type
+            index = get(vertex_index, program);
+        property_map<Graph, vertex_command_t>::type
+            cmap = get(vertex_command, program);
+        property_map<Graph, edge_condition_t>::type
+            emap = get(edge_condition, program);
+
+        mcode.resize( num_vertices(program) );
+        mvertices.resize( num_vertices(program) );
+        mbranches.clear();
+
+        graph_traits<Graph>::vertex_iterator vi, vend;
+        graph_traits<Graph>::out_edge_iterator ei, ei_end;
+        for(tie(vi,vend) = vertices(program); vi != vend; ++vi) {
+            unsigned int pc = get(index, *vi);
+            Instruction& ins = mcode[pc];
+            mvertices[pc] = *vi;
+            ins.node = &cmap[*vi];
+            ins.command = ins.node->getCommand();
+            ins.first = mbranches.size();
+            ins.reset = false;
+            for ( tie(ei, ei_end) = out_edges( *vi, program ); ei != ei_end; ++ei) {
+                Branch b;
+                b.condition = emap[*ei].getCondition();
+                b.target = b.jump = get(index, target(*ei, program));
+                if ( b.condition->isConstant() ) {
+                    if ( !b.condition->evaluate() )
+                        continue; // never taken.
+                    b.condition = 0;
+                } else
+                    ins.reset = true;
+                mbranches.push_back( b );
+                // the branches after an unconditional one are never evaluated.
+                if ( b.condition == 0 )
+                    break;
+            }
+            ins.last = mbranches.size();
+        }
+        startpc = get(index, startv);
+        exitpc  = get(index, exitv);
+
+        // Thread jumps over empty instructions, such as the ones
+        // that close a loop body. These are only skipped when running,
+        // stepping still visits every node.
+        for (unsigned int pc = 0; pc != mcode.size(); ++pc) {
+            for (unsigned int i = mcode[pc].first; i != mcode[pc].last; ++i) {
+                unsigned int t = mbranches[i].target;
+                for (unsigned int hops = 0; hops != mcode.size(); ++hops) {
+                    const Instruction& next = mcode[t];
+                    if ( t == exitpc || next.last - next.first != 1
+                         || mbranches[next.first].condition != 0
+                         || dynamic_cast<CommandNOP*>( next.command ) == 0 )
+                        break;
+                    // a jump back to pc would turn it into a wait.
+                    if ( mbranches[next.first].target == pc )
+                        break;
+                    t = mbranches[next.first].target;
+                }
+                mbranches[i].jump = t;
+            }
+        }
+    }
+
     FunctionGraph::~FunctionGraph()
     {
         //log(Debug) << "Destroying program '" << getName() << "'" <<endlog();
@@ -227,60 +295,52 @@ namespace RTT {
 
     bool FunctionGraph::executeUntil()
     {
-        graph_traits<Graph>::out_edge_iterator ei, ei_end;
-        // the map contains _references_ to all vertex_command properties
-        boost::property_map<Graph, vertex_command_t>::type
-            cmap = get(vertex_command, program);
-        boost::property_map<Graph, edge_condition_t>::type
-            emap = get(edge_condition, program);
+        const Instruction* code = &mcode[0];
+        const Branch* branches = mbranches.empty() ? 0 : &mbranches[0];
 
-        do {
-            // Check this always on entry of executeUntil :
-            // initialise current node if needed and reset all its out_edges
-            // if previous == current, we DO NOT RESET, because we want to check
-            // if previous command has completed !
-            if ( previous != current )
-                {
-                    for ( tie(ei, ei_end) = boost::out_edges( current, program ); ei != ei_end; ++ei)
-                        emap[*ei].reset();
-                    try {
-                        cmap[current].startExecution();
-                    } catch(...) {
-                        pStatus = Status::error;
-                        return false;
+        // a single handler for the whole run, instead of one for each
+        // command and condition: entering a try block is free.
+        try {
+            do {
+                const Instruction& ins = code[current];
+                // Check this always on entry of executeUntil :
+                // initialise current node if needed and reset all its out_edges
+                // if previous == current, we DO NOT RESET, because we want to check
+                // if previous command has completed !
+                if ( previous != current )
+                    {
+                        if ( ins.reset )
+                            for ( const Branch* b = branches + ins.first; b != branches + ins.last; ++b)
+                                if ( b->condition )
+                                    b->condition->reset();
+                        ins.command->reset();
+                        ins.command->readArguments();
                     }
-                }
 
-            // initial conditions :
-            previous = current;
-            // execute the current command.
-            try {
-                cmap[current].execute();
-            } catch(...) {
-                pStatus = Status::error;
-                return false;
-            }
+                // initial conditions :
+                previous = current;
+                // execute the current command.
+                ins.command->execute();
 
-            // Branch selecting Logic :
-            if ( cmap[current].isValid() ) {
-                for ( tie(ei, ei_end) = boost::out_edges( current, program ); ei != ei_end; ++ei) {
-                    try {
-                        if ( emap[*ei].evaluate() ) {
-                            current = boost::target(*ei, program);
+                // Branch selecting Logic :
+                if ( ins.command->valid() ) {
+                    for ( const Branch* b = branches + ins.first; b != branches + ins.last; ++b) {
+                        if ( b->condition == 0 || b->condition->evaluate() ) {
+                            current = b->jump;
                             // a new node has been found ...
                             // so continue
                             break; // exit from for loop.
                         }
-                    } catch(...) {
-                        pStatus = Status::error;
-                        return false;
                     }
                 }
-            }
-        } while ( previous != current && pStatus == Status::running && !pausing); // keep going if we found a new node
+            } while ( previous != current && pStatus == Status::running && !pausing); // keep going if we found a new node
+        } catch(...) {
+            pStatus = Status::error;
+            return false;
+        }
 
         // check finished state
-        if (current == exitv) {
+        if (current == exitpc) {
             this->stop();
             return !munload_on_stop;
         }
@@ -289,62 +349,52 @@ namespace RTT {
 
     bool FunctionGraph::executeStep()
     {
-        graph_traits<Graph>::out_edge_iterator ei, ei_end;
-        // the map contains _references_ to all vertex_command properties
-        boost::property_map<Graph, vertex_command_t>::type
-            cmap = get(vertex_command, program);
-        boost::property_map<Graph, edge_condition_t>::type
-            emap = get(edge_condition, program);
+        const Instruction& ins = mcode[current];
+        const Branch* branches = mbranches.empty() ? 0 : &mbranches[0];
 
-        // initialise current node if needed and reset all its out_edges
-        if ( previous != current )
-        {
-            for ( tie(ei, ei_end) = boost::out_edges( current, program ); ei != ei_end; ++ei)
-                emap[*ei].reset();
-            try {
-                cmap[current].startExecution();
-            } catch(...) {
-                pStatus = Status::error;
-                return false;
+        try {
+            // initialise current node if needed and reset all its out_edges
+            if ( previous != current )
+            {
+                if ( ins.reset )
+                    for ( const Branch* b = branches + ins.first; b != branches + ins.last; ++b)
+                        if ( b->condition )
+                            b->condition->reset();
+                ins.command->reset();
+                ins.command->readArguments();
+                previous = current;
             }
-            previous = current;
-        }
 
-        // execute the current command.
-        try {
-            cmap[current].execute();
-        } catch(...) {
-            pStatus = Status::error;
-            return false;
-        }
+            // execute the current command.
+            ins.command->execute();
 
-        // Branch selecting Logic :
-        if ( cmap[current].isValid() ) {
-            for ( tie(ei, ei_end) = boost::out_edges( current, program ); ei != ei_end; ++ei) {
-                try {
-                    if ( emap[*ei].evaluate() ) {
-                        current = boost::target(*ei, program);
-                        if (current == exitv)
+            // Branch selecting Logic :
+            if ( ins.command->valid() ) {
+                for ( const Branch* b = branches + ins.first; b != branches + ins.last; ++b) {
+                    if ( b->condition == 0 || b->condition->evaluate() ) {
+                        // take the unthreaded target, such that every node is visited.
+                        current = b->target;
+                        if (current == exitpc)
                             this->stop();
                         // a new node has been found ...
                         // it will be executed in the next step.
                         return true;
                     }
-                } catch(...) {
-                    pStatus = Status::error;
-                    return false;
                 }
             }
+        } catch(...) {
+            pStatus = Status::error;
+            return false;
         }
         // check finished state
-        if (current == exitv)
+        if (current == exitpc)
             this->stop();
         return true; // no new branch found yet !
     }
 
     void FunctionGraph::reset() {
-        current = startv;
-        previous = exitv;
+        current = startpc;
+        previous = exitpc;
         this->stop();
     }
 
@@ -377,7 +427,9 @@ namespace RTT {
 
     int FunctionGraph::getLineNumber() const
     {
-        return get(vertex_command, program)[current].getLineNumber();
+        if ( mcode.empty() )
+            return get(vertex_command, program)[startv].getLineNumber();
+        return mcode[current].node->getLineNumber();
     }
 
     FunctionGraph* FunctionGraph::copy( std::map<const DataSourceBase*, DataSourceBase*>& replacementdss ) const
@@ -417,9 +469,6 @@ namespace RTT {
 
         ret->startv = o2cmap[startv];
         ret->exitv = o2cmap[exitv];
-        ret->current = o2cmap[current];
-        ret->previous = o2cmap[previous];
-
         // so that ret itself can be copied again :
         ret->finish();
 
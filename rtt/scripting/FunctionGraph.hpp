@@ -44,6 +44,7 @@
 #include "rtt-scripting-config.h"
 #include "../base/AttributeBase.hpp"
 #include "ProgramInterface.hpp"
+#include <vector>
 
 namespace RTT
 { namespace scripting {
@@ -73,14 +74,69 @@ namespace RTT
 
     private:
         /**
-         * The node which is executed now
+         * A branch of a compiled instruction. A null condition
+         * is always true, constant conditions are folded this way.
          */
-        Vertex current;
+        struct Branch
+        {
+            ConditionInterface* condition;
+            /**
+             * The instruction this branch leads to.
+             */
+            unsigned int target;
+            /**
+             * The instruction this branch leads to after skipping
+             * empty instructions which jump unconditionally.
+             * Only used when not stepping.
+             */
+            unsigned int jump;
+        };
+
+        /**
+         * A node of the graph, lowered for execution. The branches
+         * of an instruction are mbranches[first, last), in the
+         * order of the out edges of its node.
+         */
+        struct Instruction
+        {
+            base::ActionInterface* command;
+            VertexNode* node;
+            unsigned int first;
+            unsigned int last;
+            /**
+             * False if all branches have a constant condition,
+             * which need no reset.
+             */
+            bool reset;
+        };
 
         /**
-         * The node that was run before this one.
+         * The compiled program, indexed by the vertex_index
+         * of the nodes in the graph.
          */
-        Vertex previous;
+        std::vector<Instruction> mcode;
+        std::vector<Branch> mbranches;
+        std::vector<Vertex> mvertices;
+
+        /**
+         * The instruction which is executed now
+         */
+        unsigned int current;
+
+        /**
+         * The instruction that was run before this one.
+         */
+        unsigned int previous;
+
+        unsigned int startpc;
+        unsigned int exitpc;
+
+        /**
+         * Lowers the graph into mcode and mbranches. The
+         * graph may not be modified afterwards, since the
+         * instructions point into it.
+         */
+        void compile();
 
     protected:
         /**
@@ -156,7 +212,8 @@ namespace RTT
         virtual bool needsStart() const { return !munload_on_stop; }
 
         /**
-         * To be called after a function is constructed.
+         * To be called after a function is constructed. This
+         * compiles the graph into a flat instruction array.
          */
         void finish();
 
@@ -209,14 +266,20 @@ namespace RTT
             return startv;
         }
 
+        /**
+         * The node which is executed now. Only valid after finish().
+         */
         Vertex currentNode() const
         {
-            return current;
+            return mvertices[current];
         }
 
+        /**
+         * The node that was run before this one. Only valid after finish().
+         */
         Vertex previousNode() const
         {
-            return previous;
+            return mvertices[previous];
         }
 
         Vertex exitNode() const
@@ -63,6 +63,7 @@ namespace RTT {
         : smpStatus(nill), _parent (parent) , _name(name), smStatus(Status::unloaded),
           initstate(0), finistate(0), current( 0 ), next(0), initc(0),
           currentProg(0), currentExit(0), currentHandle(0), currentEntry(0), currentRun(0), currentTrans(0),
+          tablesDirty(true), ctable(0), gtable(0),
           checking_precond(false), mstep(false), mtrace(false), evaluating(0)
     {
         this->addState(0); // allows global state transitions
@@ -100,6 +101,7 @@ namespace RTT {
                    get<5>(*tlit)->loaded( this->getEngine() );
            }
        }
+       buildTables();
    }
 
    void StateMachine::unloading() {
@@ -424,7 +426,7 @@ namespace RTT {
                         smStatus = Status::error;
                     currentTrans = transProg;
                     // manually reset reqstep, or the next iteration would skip transition checks.
-                    reqstep = stateMap.find( current )->second.begin();
+                    reqstep = ctable->transitions.begin();
                     // from now on, we are in transition to self !
                     // currentRun is _not_ set to zero or reset.
                     // it is/may be interrupted by trans, then continued.
@@ -563,6 +565,7 @@ namespace RTT {
         // add the states to the statemap.
         stateMap[from];
         stateMap[to];
+        tablesDirty = true;
         return true;
     }
 
@@ -630,24 +633,25 @@ namespace RTT {
         }
 
         // Reset global conditions.
-        TransList::const_iterator it, it1, it2;
-        it1 = stateMap.find( 0 )->second.begin();
-        it2 = stateMap.find( 0 )->second.end();
+        vector<Transition>::iterator it, it1, it2;
+        it1 = gtable->transitions.begin();
+        it2 = gtable->transitions.end();
 
-        if ( reqstep == stateMap.find( current )->second.begin() ) // avoid reseting too much in stepping mode.
+        if ( reqstep == ctable->transitions.begin() ) // avoid reseting too much in stepping mode.
             for ( it= it1; it != it2; ++it)
-                get<0>(*it)->reset();
+                if ( it->condition )
+                    it->condition->reset();
 
         if ( reqstep == reqend ) { // if nothing to evaluate, eval globals, then just handle()
 
             for ( ; it1 != it2; ++it1 )
-                if ( get<0>(*it1)->evaluate()
-                     && checkConditions( get<1>(*it1) ) == 1 ) {
-                    StateInterface* next = get<1>(*it1);
+                if ( evaluate( *it1 )
+                     && checkConditions( it1->totable ) == 1 ) {
+                    StateInterface* next = it1->to;
                     if ( next == 0 ) // handle current if no next
-                        changeState( current, get<4>(*it1).get(), stepping );
+                        changeState( current, it1->program, stepping );
                     else
-                        changeState( next, get<4>(*it1).get(), stepping );
+                        changeState( next, it1->program, stepping );
                     // the request was accepted
                     return current;
                 }
@@ -658,17 +662,17 @@ namespace RTT {
 
         // if we got here, at least one evaluation to check
         do {
-            if ( get<0>(*reqstep)->evaluate() ) {
+            if ( evaluate( *reqstep ) ) {
                 // evaluate() might call stop() or other sm functions:
                 if (reqstep == reqend )
                     return current;
                 // check preconds of target state :
-                int cres = checkConditions( get<1>(*reqstep), stepping );
+                int cres = checkConditions( reqstep->totable, stepping );
                 if (cres == 0) {
                     break; // only returned in stepping
                 }
                 if( cres == 1) {
-                    changeState( get<1>(*reqstep), get<4>(*reqstep).get(), stepping );
+                    changeState( reqstep->to, reqstep->program, stepping );
                     break; // valid transition
                 }
                 // if cres == -1 : precondition failed, increment reqstep...
@@ -676,25 +680,25 @@ namespace RTT {
              if ( reqstep + 1 == reqend ) {
                 // to a state specified by the user (global)
                 for ( ; it1 != it2; ++it1 ) {
-                    if ( get<0>(*it1)->evaluate() && checkConditions( get<1>(*it1) ) == 1 ) {
-                             StateInterface* next = get<1>(*it1);
+                    if ( evaluate( *it1 ) && checkConditions( it1->totable ) == 1 ) {
+                             StateInterface* next = it1->to;
                              if ( next == 0) // handle current if no next
-                                 changeState( current, get<4>(*it1).get(), stepping );
+                                 changeState( current, it1->program, stepping );
                              else
-                                 changeState( next, get<4>(*it1).get(), stepping );
+                                 changeState( next, it1->program, stepping );
                              // the request was accepted
                              return current;
                          }
                     }
                 // no transition was found, reset and 'schedule' a handle :
-                reqstep = stateMap.find( current )->second.begin();
-                evaluating = get<3>(*reqstep);
+                reqstep = ctable->transitions.begin();
+                evaluating = reqstep->line;
                 changeState( current, 0, stepping );
                 break;
             }
             else {
                 ++reqstep;
-                evaluating = get<3>(*reqstep);
+                evaluating = reqstep->line;
             }
         } while ( !stepping );
 
@@ -702,10 +706,19 @@ namespace RTT {
     }
 
     int StateMachine::checkConditions( StateInterface* state, bool stepping ) {
+        StateTable* table = getTable( state );
+        if ( table == 0 ) {
+            checking_precond = false;
+            return 1; // no preconditions.
+        }
+        return checkConditions( table, stepping );
+    }
+
+    int StateMachine::checkConditions( StateTable* table, bool stepping ) {
 
-        // if the preconditions of \a state are checked the first time in stepping mode, reset the iterators.
+        // if the preconditions of \a table are checked the first time in stepping mode, reset the iterators.
         if ( !checking_precond || !stepping ) {
-            prec_it = precondMap.equal_range(state); // state is the _target_ state
+            prec_it = make_pair( table->preconditions.begin(), table->preconditions.end() ); // table of the _target_ state
         }
 
         // will be set to true if stepping below.
@@ -713,18 +726,18 @@ namespace RTT {
 
         while ( prec_it.first != prec_it.second ) {
             if (checking_precond == false && stepping ) {
-                evaluating = prec_it.first->second.second; // indicate we will evaluate this line (if any).
+                evaluating = prec_it.first->second; // indicate we will evaluate this line (if any).
                 checking_precond = true;
                 return 0;
             }
-            if ( prec_it.first->second.first->evaluate() == false ) {
+            if ( prec_it.first->first->evaluate() == false ) {
                 checking_precond = false;
                 return -1; // precondition failed
             }
             ++( prec_it.first );
             if (stepping) {
                 if ( prec_it.first != prec_it.second )
-                    evaluating = prec_it.first->second.second; // indicate we will evaluate the next line (if any).
+                    evaluating = prec_it.first->second; // indicate we will evaluate the next line (if any).
                 checking_precond = true;
                 return 0; // not done yet.
             }
@@ -740,22 +753,22 @@ namespace RTT {
         // bad idea, user, don't run this if we're not active...
         if ( current == 0 )
             return 0;
-        TransList::const_iterator it1, it2;
-        it1 = stateMap.find( current )->second.begin();
-        it2 = stateMap.find( current )->second.end();
+        vector<Transition>::iterator it1, it2;
+        it1 = ctable->transitions.begin();
+        it2 = ctable->transitions.end();
 
         for ( ; it1 != it2; ++it1 )
-            if ( get<0>(*it1)->evaluate() && checkConditions( get<1>(*it1)) == 1 ) {
-                return get<1>(*it1);
+            if ( evaluate( *it1 ) && checkConditions( it1->totable ) == 1 ) {
+                return it1->to;
             }
 
         // also check the global transitions.
-        it1 = stateMap.find( 0 )->second.begin();
-        it2 = stateMap.find( 0 )->second.end();
+        it1 = gtable->transitions.begin();
+        it2 = gtable->transitions.end();
 
         for ( ; it1 != it2; ++it1 )
-            if ( get<0>(*it1)->evaluate() && checkConditions( get<1>(*it1)) == 1 ) {
-                return get<1>(*it1);
+            if ( evaluate( *it1 ) && checkConditions( it1->totable ) == 1 ) {
+                return it1->to;
             }
 
         return current;
@@ -774,6 +787,55 @@ namespace RTT {
     void StateMachine::addState( StateInterface* s )
     {
         stateMap[s];
+        tablesDirty = true;
+    }
+
+    void StateMachine::buildTables()
+    {
+        if ( !tablesDirty )
+            return;
+        tables.clear();
+        tableMap.clear();
+        // first create all tables, such that transitions can point to them.
+        tables.resize( stateMap.size() );
+        vector<StateTable>::iterator t = tables.begin();
+        for ( TransitionMap::iterator it = stateMap.begin(); it != stateMap.end(); ++it, ++t ) {
+            t->state = it->first;
+            tableMap[it->first] = &(*t);
+        }
+        t = tables.begin();
+        for ( TransitionMap::iterator it = stateMap.begin(); it != stateMap.end(); ++it, ++t ) {
+            for ( TransList::iterator tlit = it->second.begin(); tlit != it->second.end(); ++tlit ) {
+                Transition tr;
+                tr.condition = get<0>(*tlit);
+                tr.always = false;
+                // a constant condition is evaluated once, here.
+                if ( tr.condition->isConstant() ) {
+                    tr.always = tr.condition->evaluate();
+                    tr.condition = 0;
+                }
+                tr.to = get<1>(*tlit);
+                tr.totable = tableMap[ tr.to ];
+                tr.line = get<3>(*tlit);
+                tr.program = get<4>(*tlit).get();
+                t->transitions.push_back( tr );
+            }
+            pair<PreConditionMap::const_iterator, PreConditionMap::const_iterator> pr = precondMap.equal_range( it->first );
+            for ( ; pr.first != pr.second; ++pr.first )
+                t->preconditions.push_back( pr.first->second );
+        }
+        gtable = tableMap[0];
+        ctable = gtable;
+        reqstep = reqend = ctable->transitions.end();
+        tablesDirty = false;
+    }
+
+    StateMachine::StateTable* StateMachine::getTable( StateInterface* s )
+    {
+        map<StateInterface*, StateTable*>::const_iterator it = tableMap.find( s );
+        if ( it == tableMap.end() )
+            return 0;
+        return it->second;
     }
 
 
@@ -810,34 +872,35 @@ namespace RTT {
         }
 
         // between 2 states specified by the user.
-        TransList::iterator it, it1, it2;
-        it1 = stateMap.find( current )->second.begin();
-        it2 = stateMap.find( current )->second.end();
+        vector<Transition>::iterator it, it1, it2;
+        it1 = ctable->transitions.begin();
+        it2 = ctable->transitions.end();
 
         for ( ; it1 != it2; ++it1 )
-            if ( get<1>(*it1) == s_n
-                 && get<0>(*it1)->evaluate()
-                 && checkConditions( s_n ) == 1 ) {
-                changeState( s_n, get<4>(*it1).get() );
+            if ( it1->to == s_n
+                 && evaluate( *it1 )
+                 && checkConditions( it1->totable ) == 1 ) {
+                changeState( s_n, it1->program );
                 // the request was accepted
                 executePending();
                 return true;
             }
 
         // to a state specified by the user (global)
-        it1 = stateMap.find( 0 )->second.begin();
-        it2 = stateMap.find( 0 )->second.end();
+        it1 = gtable->transitions.begin();
+        it2 = gtable->transitions.end();
 
         // reset all conditions
         for ( it= it1; it != it2; ++it)
-            get<0>(*it)->reset();
+            if ( it->condition )
+                it->condition->reset();
 
         // evaluate them
         for ( ; it1 != it2; ++it1 )
-            if ( get<1>(*it1) == s_n
-                 && get<0>(*it1)->evaluate()
-                 && checkConditions( s_n ) == 1 ) {
-                changeState( s_n, get<4>(*it1).get() );
+            if ( it1->to == s_n
+                 && evaluate( *it1 )
+                 && checkConditions( it1->totable ) == 1 ) {
+                changeState( s_n, it1->program );
                 // the request was accepted
                 executePending();
                 return true;
@@ -891,6 +954,7 @@ namespace RTT {
             return;
         precondMap.insert( make_pair(state, make_pair( cnd, line)) );
         stateMap[state]; // add to state map.
+        tablesDirty = true;
     }
 
     void StateMachine::transitionSet( StateInterface* from, StateInterface* to, ConditionInterface* cnd, int priority, int line )
@@ -918,6 +982,7 @@ namespace RTT {
             ; // this ';' is intentional
         stateMap[from].insert(it, boost::make_tuple( cnd, to, priority, line, transprog ) );
         stateMap[to]; // insert empty vector for 'to' state.
+        tablesDirty = true;
     }
 
     StateInterface* StateMachine::currentState() const
@@ -973,9 +1038,11 @@ namespace RTT {
 //        TRACE( "Planning to enter state " + s->getName() );
 
         // Before a state is entered, all transitions are reset !
-        TransList::iterator it;
-        for ( it= stateMap.find(s)->second.begin(); it != stateMap.find(s)->second.end(); ++it)
-            get<0>(*it)->reset();
+        assert( ctable->state == s );
+        vector<Transition>::iterator it;
+        for ( it= ctable->transitions.begin(); it != ctable->transitions.end(); ++it)
+            if ( it->condition )
+                it->condition->reset();
 
         currentEntry = s->getEntryProgram();
         if ( currentEntry ) {
@@ -1055,13 +1122,14 @@ namespace RTT {
         // if we did not change state, it will be reset in requestNextState().
         if ( current != next ) {
             if ( next ) {
-                reqstep = stateMap.find( next )->second.begin();
-                reqend  = stateMap.find( next )->second.end();
+                ctable  = getTable( next );
+                reqstep = ctable->transitions.begin();
+                reqend  = ctable->transitions.end();
                 // init for getLineNumber() :
                 if ( reqstep == reqend )
                     evaluating = 0;
                 else
-                    evaluating = get<3>(*reqstep);
+                    evaluating = reqstep->line;
             } else {
                 current = 0;
                 return true;  // done if current == 0 !
@@ -1159,12 +1227,14 @@ namespace RTT {
     {
         initstate = s;
         stateMap[initstate];
+        tablesDirty = true;
     }
 
     void StateMachine::setFinalState( StateInterface* s )
     {
         finistate = s;
         stateMap[finistate];
+        tablesDirty = true;
     }
 
     void StateMachine::trace(bool t) {
@@ -1182,6 +1252,9 @@ namespace RTT {
 
         smpStatus = nill;
 
+        // only does something if states or transitions were added after loading.
+        buildTables();
+
         if ( this->checkConditions( getInitialState() ) != 1 ) {
             TRACE("Won't activate: preconditions failed.");
             return false; //preconditions not met.
@@ -1198,9 +1271,10 @@ namespace RTT {
 
         current = getInitialState();
         next    = getInitialState();
+        ctable  = getTable( next );
         enterState( getInitialState() );
-        reqstep = stateMap.find( next )->second.begin();
-        reqend = stateMap.find( next )->second.end();
+        reqstep = ctable->transitions.begin();
+        reqend = ctable->transitions.end();
 
         // Enable all event handlers
         enableGlobalEvents();
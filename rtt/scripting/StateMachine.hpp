@@ -633,6 +633,60 @@ namespace RTT
 
         int checkConditions( StateInterface* state, bool stepping = false );
 
+        struct StateTable;
+
+        /**
+         * A transition in the flat tables used while executing.
+         */
+        struct Transition
+        {
+            /**
+             * The condition, null if it is constant.
+             */
+            ConditionInterface* condition;
+            /**
+             * The value of a constant condition.
+             */
+            bool always;
+            StateInterface* to;
+            /**
+             * The table of \a to, to check its preconditions.
+             */
+            StateTable* totable;
+            int line;
+            ProgramInterface* program;
+        };
+
+        typedef std::vector< std::pair<ConditionInterface*, int> > PreConditionList;
+
+        /**
+         * The transitions and preconditions of one state, in the
+         * order in which stateMap and precondMap hold them.
+         */
+        struct StateTable
+        {
+            StateInterface* state;
+            std::vector<Transition> transitions;
+            PreConditionList preconditions;
+        };
+
+        /**
+         * Rebuild the tables from stateMap and precondMap
+         * if these were modified.
+         */
+        void buildTables();
+
+        /**
+         * Returns the table of state \a s, which must be in stateMap.
+         */
+        StateTable* getTable( StateInterface* s );
+
+        int checkConditions( StateTable* table, bool stepping = false );
+
+        bool evaluate( Transition& t ) {
+            return t.condition ? t.condition->evaluate() : t.always;
+        }
+
         void enableGlobalEvents();
         void disableGlobalEvents();
         void enableEvents( StateInterface* s );
@@ -677,10 +731,25 @@ namespace RTT
         ProgramInterface* currentRun;
         ProgramInterface* currentTrans;
 
-        TransList::iterator reqstep;
-        TransList::iterator reqend;
+        /**
+         * One table per state in stateMap. They are built when the
+         * StateMachine is loaded or activated, such that executing
+         * does no map lookups.
+         */
+        std::vector<StateTable> tables;
+        std::map<StateInterface*, StateTable*> tableMap;
+        bool tablesDirty;
+
+        /**
+         * The table of the current state and of the global transitions.
+         */
+        StateTable* ctable;
+        StateTable* gtable;
+
+        std::vector<Transition>::iterator reqstep;
+        std::vector<Transition>::iterator reqend;
 
-        std::pair<PreConditionMap::const_iterator,PreConditionMap::const_iterator> prec_it;
+        std::pair<PreConditionList::const_iterator,PreConditionList::const_iterator> prec_it;
         bool checking_precond;
         bool mstep, mtrace;
 
@@ -75,6 +75,9 @@ namespace RTT {
             /** This is used on to read the channel */
             typename base::ChannelElement<T>::value_t sample;
 
+            /** This is returned by readLoaned() */
+            typename base::ChannelElement<T>::value_t loaned_sample;
+
 	    DataFlowInterface* msender;
 
             /** This is used on the writing side, to avoid allocating an Any for
@@ -280,6 +283,18 @@ namespace RTT {
                 }
             }
 
+            /**
+             * Samples received over CORBA can not be loaned,
+             * so they are read into a sample of this element.
+             */
+            FlowStatus readLoaned(typename base::ChannelElement<T>::value_t const*& sample)
+            {
+                FlowStatus fs = read(loaned_sample, true);
+                if (fs != NoData)
+                    sample = &loaned_sample;
+                return fs;
+            }
+
             /**
              * CORBA IDL function.
              */
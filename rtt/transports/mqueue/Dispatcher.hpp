@@ -42,8 +42,18 @@
 #include "../../base/ChannelElementBase.hpp"
 #include "../../Logger.hpp"
 #include <map>
-#include <sys/select.h>
 #include <mqueue.h>
+#ifdef __linux__
+// On Linux, a mqd_t is a file descriptor which can be watched by epoll.
+#define ORO_MQUEUE_EPOLL
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdint.h>
+#else
+#include <sys/select.h>
+#endif
 
 namespace RTT { namespace mqueue { class Dispatcher; } }
 
@@ -58,6 +68,11 @@ namespace RTT {
          * received new data.
          * Reasonably, there should be one dispatcher for each
          * peer component sending us data.
+         *
+         * On Linux, the queues are watched edge-triggered with epoll,
+         * such that a queue is only signalled when new data arrived and
+         * adding or removing a queue takes effect immediately. Other
+         * platforms use select() with a 50ms timeout.
          */
         class Dispatcher : public Activity
         {
@@ -69,14 +84,65 @@ namespace RTT {
             typedef std::map<mqd_t,base::ChannelElementBase*> MQMap;
             MQMap mqmap;
 
+#ifdef ORO_MQUEUE_EPOLL
+            int epfd;            /* The epoll instance watching all queues */
+
+            int wakefd;          /* An eventfd which wakes up loop() for breakLoop() */
+#else
             fd_set socks;        /* Socket file descriptors we want to wake up for, using select() */
 
             int highsock;        /* Highest #'d file descriptor, needed for select() */
+#endif
 
             bool do_exit;
 
             os::Mutex maplock;
 
+#ifdef ORO_MQUEUE_EPOLL
+            Dispatcher( const std::string& name)
+            : Activity(ORO_SCHED_RT, os::HighestPriority, 0.0, 0, name),
+              epfd( epoll_create(1) ), wakefd( eventfd(0, EFD_NONBLOCK) ), do_exit(false)
+              {
+                  struct epoll_event ev;
+                  ev.events = EPOLLIN;
+                  ev.data.fd = wakefd;
+                  if ( epfd < 0 || wakefd < 0 || epoll_ctl(epfd, EPOLL_CTL_ADD, wakefd, &ev) != 0 ) {
+                      Logger::In in("Dispatcher");
+                      log(Error) << "Dispatcher failed to create its epoll instance." <<endlog();
+                  }
+              }
+
+            ~Dispatcher() {
+                Logger::In in("Dispatcher");
+                log(Info) << "Dispacher cleans up: no more work."<<endlog();
+                stop();
+                DispatchI = 0;
+                if ( wakefd >= 0 )
+                    close( wakefd );
+                if ( epfd >= 0 )
+                    close( epfd );
+            }
+
+            /**
+             * Signals the channels of the \a n queues that received new data.
+             */
+            void read_events(struct epoll_event* events, int n) {
+                os::MutexLock lock(maplock);
+                for (int i = 0; i != n; ++i) {
+                    if ( events[i].data.fd == wakefd ) {
+                        uint64_t count;
+                        if ( read(wakefd, &count, sizeof(count)) < 0 ) {
+                            // nop, the eventfd was already reset.
+                        }
+                        continue;
+                    }
+                    // the queue may have been removed since epoll_wait returned.
+                    MQMap::iterator it = mqmap.find( events[i].data.fd );
+                    if ( it != mqmap.end() )
+                        it->second->signal();
+                }
+            }
+#else
             Dispatcher( const std::string& name)
             : Activity(ORO_SCHED_RT, os::HighestPriority, 0.0, 0, name),
               highsock(0), do_exit(false)
@@ -127,6 +193,7 @@ namespace RTT {
                     }
                 }
             }
+#endif
 
         public:
             typedef boost::intrusive_ptr<Dispatcher> shared_ptr;
@@ -148,8 +215,18 @@ namespace RTT {
                 log(Debug) <<"Dispatcher is monitoring mqdes "<< mqdes <<endlog();
                 os::MutexLock lock(maplock);
                 // we add a refcount per channel we monitor.
-                if (mqmap.count(mqdes) == 0)
+                if (mqmap.count(mqdes) == 0) {
+#ifdef ORO_MQUEUE_EPOLL
+                    struct epoll_event ev;
+                    ev.events = EPOLLIN | EPOLLET;
+                    ev.data.fd = mqdes;
+                    if ( epoll_ctl(epfd, EPOLL_CTL_ADD, mqdes, &ev) != 0 ) {
+                        log(Error) <<"Dispatcher failed to watch mqdes "<< mqdes <<endlog();
+                        return;
+                    }
+#endif
                     refcount.inc();
+                }
                 mqmap[mqdes] = chan;
             }
 
@@ -158,6 +235,9 @@ namespace RTT {
                 log(Debug) <<"Dispatcher drops mqdes "<< mqdes <<endlog();
                 os::MutexLock lock(maplock);
                 if (mqmap.count(mqdes)) {
+#ifdef ORO_MQUEUE_EPOLL
+                    epoll_ctl(epfd, EPOLL_CTL_DEL, mqdes, 0);
+#endif
                     mqmap.erase( mqmap.find(mqdes) );
                     refcount.dec();
                 }
@@ -168,6 +248,32 @@ namespace RTT {
                 return true;
             }
 
+#ifdef ORO_MQUEUE_EPOLL
+            void loop() {
+                struct epoll_event events[16];
+                while (1) {
+                    int n = epoll_wait(epfd, events, 16, -1);
+                    if (n < 0) {
+                        if (errno == EINTR)
+                            continue;
+                        log(Error) <<"Dispatcher failed to wait on message queues. Stopped thread."<<endlog();
+                        return;
+                    }
+                    read_events(events, n);
+
+                    if ( do_exit )
+                        return;
+                }
+            }
+
+            bool breakLoop() {
+                do_exit = true;
+                uint64_t one = 1;
+                if ( write(wakefd, &one, sizeof(one)) < 0 )
+                    return false;
+                return true;
+            }
+#else
             void loop() {
                 struct timeval timeout;  /* Timeout for select */
                 int readsocks;       /* Number of sockets ready for reading */
@@ -209,6 +315,7 @@ namespace RTT {
                 do_exit = true;
                 return true;
             }
+#endif
         };
     }
 }
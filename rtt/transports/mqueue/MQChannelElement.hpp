@@ -135,13 +135,11 @@ namespace RTT
                 if (mis_sender) {
                     // this read should always succeed since signal() means
                     // 'data available in a data element'.
-                    typename base::ChannelElement<T>::shared_ptr input =
-                        this->getInput();
+                    base::ChannelElement<T>* input = this->currentInput();
                     if( input && input->read(read_sample->set(), false) == NewData )
                         return this->write(read_sample->rvalue());
                 } else {
-                    typename base::ChannelElement<T>::shared_ptr output =
-                        this->getOutput();
+                    base::ChannelElement<T>* output = this->currentOutput();
                     if (output && mqRead(read_sample))
                         return output->write(read_sample->rvalue());
                 }
@@ -0,0 +1,80 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  ShmLib.cpp
+
+                        ShmLib.cpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "ShmLib.hpp"
+#include "ShmTemplateProtocol.hpp"
+#include "../../types/TransportPlugin.hpp"
+#include "../../types/TypekitPlugin.hpp"
+
+using namespace std;
+using namespace RTT::detail;
+
+namespace RTT {
+    namespace shm {
+        bool ShmLibPlugin::registerTransport(std::string name, TypeInfo* ti)
+        {
+            if ( name == "int" )
+                return ti->addProtocol(ORO_SHM_PROTOCOL_ID, new ShmTemplateProtocol<int>() );
+            if ( name == "double" )
+                return ti->addProtocol(ORO_SHM_PROTOCOL_ID, new ShmTemplateProtocol<double>() );
+            if ( name == "float" )
+                return ti->addProtocol(ORO_SHM_PROTOCOL_ID, new ShmTemplateProtocol<float>() );
+            if ( name == "uint" )
+                return ti->addProtocol(ORO_SHM_PROTOCOL_ID, new ShmTemplateProtocol<unsigned int>() );
+            if ( name == "char" )
+                return ti->addProtocol(ORO_SHM_PROTOCOL_ID, new ShmTemplateProtocol<char>() );
+            if ( name == "bool" )
+                return ti->addProtocol(ORO_SHM_PROTOCOL_ID, new ShmTemplateProtocol<bool>() );
+            return false;
+        }
+
+        std::string ShmLibPlugin::getTransportName() const {
+            return "shm";
+        }
+
+        std::string ShmLibPlugin::getTypekitName() const {
+            return "rtt-types";
+        }
+        std::string ShmLibPlugin::getName() const {
+            return "rtt-shm-transport";
+        }
+    }
+}
+
+ORO_TYPEKIT_PLUGIN( RTT::shm::ShmLibPlugin )
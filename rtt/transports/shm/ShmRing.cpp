@@ -0,0 +1,316 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  ShmRing.cpp
+
+                        ShmRing.cpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <linux/futex.h>
+#include <unistd.h>
+#include <limits.h>
+#include <errno.h>
+#include <time.h>
+#include <cstring>
+
+#include "ShmRing.hpp"
+#include "../../os/CAS.hpp"
+#include "../../Logger.hpp"
+
+#define ORO_SHM_CACHELINE 64
+#define ORO_SHM_MAGIC 0x4f53484d
+#define ORO_SHM_SLOT_HEADER 8
+
+namespace RTT
+{
+    namespace shm
+    {
+        /**
+         * The layout of the start of a segment. The indexes and the
+         * futex word each have their own cache line, such that writers,
+         * the reader and wakeups don't false share.
+         */
+        struct ShmRingHeader
+        {
+            /** 0: being created, ORO_SHM_MAGIC: ready for use. */
+            volatile int state;
+            unsigned int capacity;
+            unsigned int slot_size;
+            unsigned int stride;
+            char pad0[ORO_SHM_CACHELINE - 4 * sizeof(int)];
+            volatile unsigned int head;
+            char pad1[ORO_SHM_CACHELINE - sizeof(int)];
+            volatile unsigned int tail;
+            char pad2[ORO_SHM_CACHELINE - sizeof(int)];
+            volatile int futex;
+            volatile int waiting;
+            char pad3[ORO_SHM_CACHELINE - 2 * sizeof(int)];
+        };
+
+        /**
+         * The header of each slot, followed by the data.
+         */
+        struct ShmSlot
+        {
+            volatile unsigned int seq;
+            unsigned int length;
+        };
+    }
+}
+
+using namespace RTT;
+using namespace RTT::shm;
+
+namespace {
+    int futex(volatile int* addr, int op, int val, const struct timespec* timeout)
+    {
+        return syscall(SYS_futex, addr, op, val, timeout, 0, 0);
+    }
+}
+
+ShmRing::ShmRing()
+    : hdr(0), slots(0), mapped_size(0)
+{
+}
+
+ShmRing::~ShmRing()
+{
+    close();
+}
+
+bool ShmRing::open(const std::string& name, unsigned int capacity, unsigned int slot_size)
+{
+    Logger::In in("ShmRing");
+    close();
+    unsigned int cap = 1;
+    while ( cap < capacity )
+        cap <<= 1;
+    unsigned int stride = ORO_SHM_SLOT_HEADER + ((slot_size + 7) & ~7u);
+
+    bool creator = true;
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if ( fd < 0 && errno == EEXIST ) {
+        creator = false;
+        fd = shm_open(name.c_str(), O_RDWR, 0);
+    }
+    if ( fd < 0 ) {
+        log(Error) << "Could not open shared memory segment '" << name << "': " << strerror(errno) << endlog();
+        return false;
+    }
+
+    size_t size = 0;
+    if ( creator ) {
+        size = sizeof(ShmRingHeader) + size_t(cap) * stride;
+        if ( ftruncate(fd, size) != 0 ) {
+            log(Error) << "Could not size shared memory segment '" << name << "' to " << size << " bytes: " << strerror(errno) << endlog();
+            ::close(fd);
+            shm_unlink(name.c_str());
+            return false;
+        }
+    } else {
+        // the creator sizes the segment once, right after creating it.
+        struct stat st;
+        for (int i = 0; i != 1000; ++i) {
+            if ( fstat(fd, &st) == 0 && size_t(st.st_size) >= sizeof(ShmRingHeader) ) {
+                size = st.st_size;
+                break;
+            }
+            struct timespec ts = { 0, 1000000 };
+            nanosleep(&ts, 0);
+        }
+    }
+
+    void* mem = size ? mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if ( mem == MAP_FAILED ) {
+        log(Error) << "Could not map shared memory segment '" << name << "'." << endlog();
+        if ( creator )
+            shm_unlink(name.c_str());
+        return false;
+    }
+    hdr = static_cast<ShmRingHeader*>(mem);
+    slots = static_cast<char*>(mem) + sizeof(ShmRingHeader);
+    mapped_size = size;
+    mname = name;
+
+    if ( creator ) {
+        hdr->capacity = cap;
+        hdr->slot_size = stride - ORO_SHM_SLOT_HEADER;
+        hdr->stride = stride;
+        hdr->head = 0;
+        hdr->tail = 0;
+        hdr->futex = 0;
+        hdr->waiting = 0;
+        // touches each slot, so that no page faults happen later on.
+        for (unsigned int i = 0; i != cap; ++i) {
+            ShmSlot* s = reinterpret_cast<ShmSlot*>( slots + size_t(i) * stride );
+            s->seq = i;
+            s->length = 0;
+        }
+        __sync_synchronize();
+        hdr->state = ORO_SHM_MAGIC;
+    } else {
+        for (int i = 0; i != 1000 && hdr->state != ORO_SHM_MAGIC; ++i) {
+            struct timespec ts = { 0, 1000000 };
+            nanosleep(&ts, 0);
+        }
+        __sync_synchronize();
+        if ( hdr->state != ORO_SHM_MAGIC
+             || sizeof(ShmRingHeader) + size_t(hdr->capacity) * hdr->stride > mapped_size ) {
+            log(Error) << "Shared memory segment '" << name << "' was not initialised by its creator." << endlog();
+            close();
+            return false;
+        }
+    }
+    log(Debug) << (creator ? "Created '" : "Opened '") << name << "' with " << hdr->capacity
+               << " slots of " << hdr->slot_size << " bytes." << endlog();
+    return true;
+}
+
+void ShmRing::close()
+{
+    if ( hdr )
+        munmap(hdr, mapped_size);
+    hdr = 0;
+    slots = 0;
+    mapped_size = 0;
+}
+
+void ShmRing::unlink()
+{
+    if ( !mname.empty() )
+        shm_unlink( mname.c_str() );
+}
+
+unsigned int ShmRing::getSlotSize() const
+{
+    return hdr ? hdr->slot_size : 0;
+}
+
+unsigned int ShmRing::getCapacity() const
+{
+    return hdr ? hdr->capacity : 0;
+}
+
+char* ShmRing::slot(unsigned int pos) const
+{
+    return slots + size_t(pos & (hdr->capacity - 1)) * hdr->stride;
+}
+
+char* ShmRing::beginWrite(unsigned int& pos)
+{
+    for (;;) {
+        pos = hdr->head;
+        ShmSlot* s = reinterpret_cast<ShmSlot*>( slot(pos) );
+        int dif = int(s->seq - pos);
+        if ( dif == 0 ) {
+            if ( os::CAS(&hdr->head, pos, pos + 1) )
+                return reinterpret_cast<char*>(s) + ORO_SHM_SLOT_HEADER;
+        } else if ( dif < 0 ) {
+            return 0; // full
+        }
+        // else: another writer took this slot, try the next one.
+    }
+}
+
+void ShmRing::commitWrite(unsigned int pos, unsigned int length)
+{
+    ShmSlot* s = reinterpret_cast<ShmSlot*>( slot(pos) );
+    s->length = length;
+    __sync_synchronize();
+    s->seq = pos + 1;
+    // full barrier: orders the publication against reading 'waiting'.
+    __sync_fetch_and_add(&hdr->futex, 1);
+    if ( hdr->waiting )
+        futex(&hdr->futex, FUTEX_WAKE, 1, 0);
+}
+
+const char* ShmRing::beginRead(unsigned int& length)
+{
+    unsigned int pos = hdr->tail;
+    ShmSlot* s = reinterpret_cast<ShmSlot*>( slot(pos) );
+    if ( int(s->seq - (pos + 1)) < 0 )
+        return 0;
+    __sync_synchronize();
+    length = s->length;
+    return reinterpret_cast<char*>(s) + ORO_SHM_SLOT_HEADER;
+}
+
+void ShmRing::commitRead()
+{
+    unsigned int pos = hdr->tail;
+    ShmSlot* s = reinterpret_cast<ShmSlot*>( slot(pos) );
+    __sync_synchronize();
+    s->seq = pos + hdr->capacity;
+    hdr->tail = pos + 1;
+}
+
+bool ShmRing::empty() const
+{
+    unsigned int pos = hdr->tail;
+    ShmSlot* s = reinterpret_cast<ShmSlot*>( slot(pos) );
+    return int(s->seq - (pos + 1)) < 0;
+}
+
+bool ShmRing::waitData(long long timeout_ns)
+{
+    int val = hdr->futex;
+    if ( !empty() )
+        return true;
+    hdr->waiting = 1;
+    __sync_synchronize();
+    if ( empty() && hdr->futex == val ) {
+        if ( timeout_ns < 0 ) {
+            futex(&hdr->futex, FUTEX_WAIT, val, 0);
+        } else {
+            struct timespec ts;
+            ts.tv_sec = timeout_ns / 1000000000LL;
+            ts.tv_nsec = timeout_ns % 1000000000LL;
+            futex(&hdr->futex, FUTEX_WAIT, val, &ts);
+        }
+    }
+    hdr->waiting = 0;
+    return !empty();
+}
+
+void ShmRing::wakeup()
+{
+    __sync_fetch_and_add(&hdr->futex, 1);
+    futex(&hdr->futex, FUTEX_WAKE, INT_MAX, 0);
+}
@@ -0,0 +1,161 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  ShmRing.hpp
+
+                        ShmRing.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_SHM_RING_HPP
+#define ORO_SHM_RING_HPP
+
+#include "rtt-shm-config.h"
+#include <string>
+
+namespace RTT
+{
+    namespace shm
+    {
+        struct ShmRingHeader;
+
+        /**
+         * A bounded multi-producer, single-consumer queue of fixed size
+         * slots which lives in a POSIX shared memory segment. Writers
+         * reserve a slot with a CAS on the head index, marshal the
+         * sample straight into it and publish it with a per-slot sequence
+         * number. The single reader consumes slots in order and sleeps
+         * on a futex in the segment when the queue is empty, which works
+         * across process boundaries.
+         *
+         * The process that creates the segment decides its geometry,
+         * processes that open an existing segment adopt it.
+         */
+        class RTT_SHM_API ShmRing
+        {
+            ShmRingHeader* hdr;
+            char* slots;
+            unsigned int mapped_size;
+            std::string mname;
+
+            char* slot(unsigned int pos) const;
+        public:
+            ShmRing();
+
+            /**
+             * Unmaps the segment, but does not unlink it.
+             */
+            ~ShmRing();
+
+            /**
+             * Creates or opens the shared memory segment \a name.
+             * @param name The POSIX shared memory object name, it
+             * must start with a '/'.
+             * @param capacity The minimal number of slots, it is
+             * rounded up to a power of two. Ignored if the segment exists.
+             * @param slot_size The maximal size of one sample in bytes.
+             * Ignored if the segment exists.
+             * @return false if the segment could not be created or
+             * did not become ready in time.
+             */
+            bool open(const std::string& name, unsigned int capacity, unsigned int slot_size);
+
+            /**
+             * Unmaps the segment.
+             */
+            void close();
+
+            /**
+             * Removes the name of the segment from the system, such that
+             * no new readers or writers can open it.
+             */
+            void unlink();
+
+            bool isOpen() const { return hdr != 0; }
+
+            /**
+             * The size in bytes of the data part of each slot.
+             */
+            unsigned int getSlotSize() const;
+
+            /**
+             * The number of slots in the ring.
+             */
+            unsigned int getCapacity() const;
+
+            /**
+             * Reserves a slot for writing.
+             * @param pos Is set to the ticket which must be given to commitWrite()
+             * @return the data part of the slot, or null if the ring is full.
+             */
+            char* beginWrite(unsigned int& pos);
+
+            /**
+             * Publishes a slot reserved by beginWrite() and wakes up the
+             * reader if it is sleeping.
+             * @param length The number of bytes written in the slot. Zero
+             * marks a slot which the reader must skip.
+             */
+            void commitWrite(unsigned int pos, unsigned int length);
+
+            /**
+             * Returns the oldest published slot, or null if the ring is empty.
+             * Only one thread may read from the ring.
+             */
+            const char* beginRead(unsigned int& length);
+
+            /**
+             * Releases the slot returned by beginRead().
+             */
+            void commitRead();
+
+            bool empty() const;
+
+            /**
+             * Blocks until the ring is not empty, wakeup() was called or
+             * the timeout expired.
+             * @param timeout_ns The relative timeout, or a negative number
+             * to wait forever.
+             * @return true if the ring is not empty.
+             */
+            bool waitData(long long timeout_ns);
+
+            /**
+             * Wakes up a reader blocked in waitData().
+             */
+            void wakeup();
+        };
+    }
+}
+
+#endif
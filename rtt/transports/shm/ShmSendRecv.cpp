@@ -0,0 +1,219 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  ShmSendRecv.cpp
+
+                        ShmSendRecv.cpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include <unistd.h>
+#include <sstream>
+#include <stdexcept>
+#include <cstring>
+
+#include "ShmSendRecv.hpp"
+#include "../../types/TypeMarshaller.hpp"
+#include "../../Logger.hpp"
+#include "../../Activity.hpp"
+#include "../../base/ChannelElementBase.hpp"
+#include "../../base/PortInterface.hpp"
+#include "../../DataFlowInterface.hpp"
+#include "../../TaskContext.hpp"
+
+using namespace RTT;
+using namespace RTT::detail;
+using namespace RTT::shm;
+
+namespace RTT
+{
+    namespace shm
+    {
+        /**
+         * Blocks on the futex of one ring and forwards each new
+         * sample to the receiving channel element. The futex of a
+         * shared ring can not be multiplexed like the mqueue file
+         * descriptors, so there is one such thread per receiving
+         * connection.
+         */
+        class ShmReceiver : public Activity
+        {
+            ShmRing& mring;
+            base::ChannelElementBase* mchan;
+            volatile bool do_exit;
+        public:
+            ShmReceiver(ShmRing& ring, base::ChannelElementBase* chan, const std::string& name)
+                : Activity(ORO_SCHED_RT, os::HighestPriority, 0.0, 0, name),
+                  mring(ring), mchan(chan), do_exit(false)
+            {}
+
+            ~ShmReceiver() {
+                stop();
+            }
+
+            void loop() {
+                while ( !do_exit ) {
+                    if ( mring.waitData(-1) )
+                        while ( !do_exit && mchan->signal() )
+                            ;
+                }
+            }
+
+            bool breakLoop() {
+                do_exit = true;
+                mring.wakeup();
+                return true;
+            }
+        };
+    }
+}
+
+ShmSendRecv::ShmSendRecv(types::TypeMarshaller const& transport) :
+    mtransport(transport), marshaller_cookie(0), mreceiver(0), mis_sender(false), minit_done(false)
+{
+}
+
+void ShmSendRecv::setupStream(base::DataSourceBase::shared_ptr ds, base::PortInterface* port, ConnPolicy const& policy,
+                              bool is_sender)
+{
+    Logger::In in("ShmSendRecv");
+
+    int slot_size = policy.data_size ? policy.data_size : mtransport.getSampleSize(ds);
+    marshaller_cookie = mtransport.createCookie();
+    mis_sender = is_sender;
+
+    std::stringstream namestr;
+    namestr << '/' << port->getInterface()->getOwner()->getName() << '.' << port->getName() << '.' << this << '@' << getpid();
+
+    if (policy.name_id.empty())
+        policy.name_id = namestr.str();
+
+    if (policy.name_id[0] != '/' || policy.name_id.find('/', 1) != std::string::npos)
+        throw std::runtime_error("Could not open shared memory ring with wrong name. Names must start with '/' and contain no more '/' after the first one.");
+    if (slot_size <= 0)
+        throw std::runtime_error("Could not open shared memory ring with zero sample size.");
+
+    if ( !mring.open(policy.name_id, policy.size ? policy.size : 10, slot_size) )
+        throw std::runtime_error("Could not open shared memory ring '" + policy.name_id + "'.");
+
+    log(Debug) << "Opened '" << policy.name_id << "' for " << (is_sender ? "writing." : "reading.") << endlog();
+    mshmname = policy.name_id;
+}
+
+ShmSendRecv::~ShmSendRecv()
+{
+    delete mreceiver;
+}
+
+void ShmSendRecv::cleanupStream()
+{
+    if (!mis_sender)
+    {
+        if (minit_done)
+        {
+            delete mreceiver;
+            mreceiver = 0;
+            minit_done = false;
+        }
+    }
+    else
+    {
+        // sender unlinks to avoid future re-use of new readers.
+        mring.unlink();
+    }
+    // both sender and receiver unmap their end.
+    mring.close();
+
+    if (marshaller_cookie)
+        mtransport.deleteCookie(marshaller_cookie);
+    marshaller_cookie = 0;
+}
+
+bool ShmSendRecv::shmReady(base::DataSourceBase::shared_ptr ds, base::ChannelElementBase* chan)
+{
+    if (minit_done)
+        return true;
+
+    if (mis_sender)
+        return false; // we can only receive inputReady on the input port side.
+
+    // Try to get the initial sample
+    //
+    // The output port implementation guarantees that there will be one
+    // after the connection is ready
+    if ( !mring.waitData( Seconds_to_nsecs(0.5) ) ) {
+        log(Error) << "Failed to receive initial data sample for Shm Channel Element." << endlog();
+        return false;
+    }
+    if ( !shmRead(ds) ) {
+        log(Error) << "Failed to initialize Shm Channel Element with initial data sample." << endlog();
+        return false;
+    }
+    minit_done = true;
+    // ok, now we can wait for new samples.
+    mreceiver = new ShmReceiver(mring, chan, "ShmReceiver" + mshmname);
+    mreceiver->start();
+    return true;
+}
+
+bool ShmSendRecv::shmRead(base::DataSourceBase::shared_ptr ds)
+{
+    unsigned int length = 0;
+    const char* data = mring.beginRead(length);
+    if ( data == 0 )
+        return false;
+    bool result = length != 0 && mtransport.updateFromBlob((void const*) data, length, ds, marshaller_cookie);
+    mring.commitRead();
+    return result;
+}
+
+bool ShmSendRecv::shmWrite(base::DataSourceBase::shared_ptr ds)
+{
+    unsigned int pos;
+    char* slot = mring.beginWrite(pos);
+    if ( slot == 0 )
+        return true; // ring full: the sample is dropped, like a full mqueue.
+
+    std::pair<void const*, int> blob = mtransport.fillBlob(ds, slot, mring.getSlotSize(), marshaller_cookie);
+    if (blob.first == 0 || blob.second > int(mring.getSlotSize()))
+    {
+        mring.commitWrite(pos, 0);
+        log(Error) << "ShmChannel: failed to marshal sample in slot of " << mring.getSlotSize() << " bytes" << endlog();
+        return false;
+    }
+    // marshallers of trivial types return the sample itself.
+    if ( blob.first != slot )
+        memcpy(slot, blob.first, blob.second);
+    mring.commitWrite(pos, blob.second);
+    return true;
+}
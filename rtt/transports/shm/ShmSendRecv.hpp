@@ -0,0 +1,138 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  ShmSendRecv.hpp
+
+                        ShmSendRecv.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_SHM_SENDRECV_HPP
+#define ORO_SHM_SENDRECV_HPP
+
+#include "rtt-shm-config.h"
+#include "ShmRing.hpp"
+#include "../../rtt-fwd.hpp"
+#include "../../base/DataSourceBase.hpp"
+
+namespace RTT
+{
+    namespace shm
+    {
+        class ShmReceiver;
+
+        /**
+         * Implements the sending/receiving of samples through a shared
+         * memory ring. It can only be OR sender OR receiver (logical XOR).
+         *
+         * Samples are marshalled directly into the slots of the ring and
+         * unmarshalled directly from them, so there is no intermediate
+         * send or receive buffer. For types that are transported with
+         * the ShmTemplateProtocol this amounts to a single memcpy on each
+         * side.
+         */
+        class RTT_SHM_API ShmSendRecv
+        {
+        protected:
+            /**
+             * Transport marshaller used for size calculations
+             * and data updates.
+             */
+            types::TypeMarshaller const& mtransport;
+            /**
+             * A private blob that is returned by mtransport.createCookie(). It is
+             * used by the marshallers if they need private internal data to do
+             * the marshalling
+             */
+            void* marshaller_cookie;
+            /**
+             * The shared memory ring.
+             */
+            ShmRing mring;
+            /**
+             * The thread that waits for new samples in the ring,
+             * only present on the receiving side, after shmReady().
+             */
+            ShmReceiver* mreceiver;
+            /**
+             * True if this object is a sender.
+             */
+            bool mis_sender;
+            /**
+             * True if setupStream() was called, false after cleanupStream().
+             */
+            bool minit_done;
+            /**
+             * The name of the segment, as specified in the ConnPolicy when
+             * creating the stream, or self-calculated when that name was empty.
+             */
+            std::string mshmname;
+
+        public:
+            /**
+             * Create a channel element for remote data exchange.
+             * @param transport The type specific object that will be used to marshal the data.
+             */
+            ShmSendRecv(types::TypeMarshaller const& transport);
+
+            void setupStream(base::DataSourceBase::shared_ptr ds, base::PortInterface* port, ConnPolicy const& policy, bool is_sender);
+
+            ~ShmSendRecv();
+
+            void cleanupStream();
+
+            /**
+             * Works only in receive mode, waits for the initial sample and
+             * starts the thread which forwards new samples to \a chan.
+             * @return true if the initial sample was received.
+             */
+            virtual bool shmReady(base::DataSourceBase::shared_ptr ds, base::ChannelElementBase* chan);
+
+            /**
+             * Read from the ring.
+             * @param ds stores the resulting data sample.
+             * @return true if an item could be read.
+             */
+            bool shmRead(base::DataSourceBase::shared_ptr ds);
+
+            /**
+             * Write to the ring. The sample is dropped if the ring is full.
+             * @param ds the data sample to write
+             * @return false if the sample could not be marshalled.
+             */
+            bool shmWrite(base::DataSourceBase::shared_ptr ds);
+        };
+    }
+}
+
+#endif
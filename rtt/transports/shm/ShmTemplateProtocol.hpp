@@ -0,0 +1,115 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  ShmTemplateProtocol.hpp
+
+                        ShmTemplateProtocol.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_SHM_TEMPLATE_PROTOCOL_HPP
+#define ORO_SHM_TEMPLATE_PROTOCOL_HPP
+
+#include "ShmLib.hpp"
+#include "ShmChannelElement.hpp"
+#include "../../types/TypeMarshaller.hpp"
+
+#include <boost/type_traits/has_virtual_destructor.hpp>
+#include <boost/static_assert.hpp>
+
+namespace RTT
+{ namespace shm
+  {
+      /**
+       * For each transportable type T, specify the conversion functions.
+       * The sample is copied with a single memcpy into and out of the
+       * shared memory ring.
+       * @warning This can only be used if T is a trivial type without
+       * meaningful (copy) constructor.
+       */
+      template<class T>
+      class ShmTemplateProtocol
+          : public RTT::types::TypeMarshaller
+      {
+      public:
+          /**
+           * We don't support types with virtual functions !
+           */
+          BOOST_STATIC_ASSERT( !boost::has_virtual_destructor<T>::value );
+          /**
+           * The given \a T parameter is the type for reading DataSources.
+           */
+          typedef T UserType;
+
+          virtual base::ChannelElementBase::shared_ptr createStream(base::PortInterface* port, const ConnPolicy& policy, bool is_sender) const {
+              try {
+                  base::ChannelElementBase::shared_ptr shm = new ShmChannelElement<T>(port, *this, policy, is_sender);
+                  if ( !is_sender ) {
+                      // the receiver needs a buffer to store his messages in.
+                      base::ChannelElementBase::shared_ptr buf = detail::DataSourceTypeInfo<T>::getTypeInfo()->buildDataStorage(policy);
+                      shm->setOutput(buf);
+                  }
+                  return shm;
+              } catch(std::exception& e) {
+                  log(Error) << "Failed to create Shm Channel element: " << e.what() << endlog();
+              }
+              return base::ChannelElementBase::shared_ptr();
+          }
+
+          virtual std::pair<void const*,int> fillBlob( base::DataSourceBase::shared_ptr source, void* blob, int size, void* cookie) const
+          {
+              if ( sizeof(T) <= (unsigned int)size)
+                  return std::make_pair(source->getRawConstPointer(), int(sizeof(T)));
+              return std::make_pair((void const*)0,int(0));
+          }
+
+          virtual bool updateFromBlob(const void* blob, int size, base::DataSourceBase::shared_ptr target, void* cookie) const
+          {
+            typename internal::AssignableDataSource<T>::shared_ptr ad = internal::AssignableDataSource<T>::narrow( target.get() );
+            assert( size == sizeof(T) );
+            if ( ad ) {
+                ad->set( *(T const*)(blob) );
+                return true;
+            }
+            return false;
+          }
+
+          virtual unsigned int getSampleSize(base::DataSourceBase::shared_ptr ignored, void* cookie) const
+          {
+              return sizeof(T);
+          }
+      };
+}
+}
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef ORO_RTT_shm_FWD_HPP
+#define ORO_RTT_shm_FWD_HPP
+
+namespace RTT {
+    namespace shm {
+        class ShmRing;
+        class ShmReceiver;
+        template<class T>
+        class ShmTemplateProtocol;
+        template<typename T>
+        class ShmChannelElement;
+    }
+    namespace detail {
+        using namespace shm;
+    }
+}
+#endif
@@ -0,0 +1,73 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  ConnectionStatisticsType.hpp
+
+                        ConnectionStatisticsType.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_CONNECTIONSTATISTICSTYPE_HPP_
+#define ORO_CONNECTIONSTATISTICSTYPE_HPP_
+
+#include <boost/serialization/serialization.hpp>
+#include "../ConnectionStatistics.hpp"
+#include "ConnPolicyType.hpp"
+
+namespace boost {
+    namespace serialization {
+        /**
+         * Serializes RTT::ConnectionStatistics objects.
+         * @param a Any boost::serialization compatible archive
+         * @param s A ConnectionStatistics that will be read or written.
+         */
+        template<class Archive>
+        void serialize(Archive& a, RTT::ConnectionStatistics& s, unsigned int) {
+            a & boost::serialization::make_nvp("port", s.port);
+            a & boost::serialization::make_nvp("policy", s.policy);
+            a & boost::serialization::make_nvp("writes", s.writes);
+            a & boost::serialization::make_nvp("drops", s.drops);
+            a & boost::serialization::make_nvp("overwrites", s.overwrites);
+            a & boost::serialization::make_nvp("high_water_mark", s.high_water_mark);
+            a & boost::serialization::make_nvp("reads", s.reads);
+            a & boost::serialization::make_nvp("new_data", s.new_data);
+            a & boost::serialization::make_nvp("old_data", s.old_data);
+            a & boost::serialization::make_nvp("no_data", s.no_data);
+            a & boost::serialization::make_nvp("last_write", s.last_write);
+            a & boost::serialization::make_nvp("last_read", s.last_read);
+        }
+    }
+}
+
+
+#endif /* ORO_CONNECTIONSTATISTICSTYPE_HPP_ */
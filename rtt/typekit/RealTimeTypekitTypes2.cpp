@@ -46,11 +46,14 @@
 #include "../types/SequenceTypeInfo.hpp"
 #include "StdTypeInfo.hpp"
 #include "../types/StructTypeInfo.hpp"
+#include "../types/CArrayTypeInfo.hpp"
 
 #include "../rtt-fwd.hpp"
 #include "../FlowStatus.hpp"
 #include "../ConnPolicy.hpp"
 #include "ConnPolicyType.hpp"
+#include "ThreadStatisticsType.hpp"
+#include "ConnectionStatisticsType.hpp"
 #include "TaskContext.hpp"
 
 namespace RTT
@@ -71,6 +74,10 @@ namespace RTT
              ti->addType( new StdTypeInfo<SendStatus>("SendStatus"));
              ti->addType( new TemplateTypeInfo<PropertyBag, true>("PropertyBag") );
              ti->addType( new StructTypeInfo<ConnPolicy,false>("ConnPolicy") );
+             ti->addType( new StructTypeInfo<os::ThreadStatistics,false>("ThreadStatistics") );
+             ti->addType( new StructTypeInfo<ConnectionStatistics,false>("ConnectionStatistics") );
+             ti->addType( new SequenceTypeInfo<std::vector<ConnectionStatistics> >("ConnectionStatistics[]") );
+             ti->addType( new CArrayTypeInfo< carray<unsigned int> >("uint[]") );
              ti->addType( new TemplateTypeInfo<EmptySendHandle>("SendHandle") ); //dummy, replaced by real stuff when seen by parser.
              ti->addType( new TemplateTypeInfo<TaskContext*>("TaskContext"));
          }
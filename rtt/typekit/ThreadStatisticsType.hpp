@@ -0,0 +1,71 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  ThreadStatisticsType.hpp
+
+                        ThreadStatisticsType.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_THREADSTATISTICSTYPE_HPP_
+#define ORO_THREADSTATISTICSTYPE_HPP_
+
+#include <boost/serialization/serialization.hpp>
+#include "../os/ThreadStatistics.hpp"
+
+namespace boost {
+    namespace serialization {
+        /**
+         * Serializes RTT::os::ThreadStatistics objects.
+         * @param a Any boost::serialization compatible archive
+         * @param s A ThreadStatistics that will be read or written.
+         */
+        template<class Archive>
+        void serialize(Archive& a, RTT::os::ThreadStatistics& s, unsigned int) {
+            a & boost::serialization::make_nvp("cycles", s.cycles);
+            a & boost::serialization::make_nvp("overruns", s.overruns);
+            a & boost::serialization::make_nvp("wakeups", s.wakeups);
+            a & boost::serialization::make_nvp("step_min", s.step_min);
+            a & boost::serialization::make_nvp("step_max", s.step_max);
+            a & boost::serialization::make_nvp("step_mean", s.step_mean);
+            a & boost::serialization::make_nvp("latency_min", s.latency_min);
+            a & boost::serialization::make_nvp("latency_max", s.latency_max);
+            a & boost::serialization::make_nvp("latency_mean", s.latency_mean);
+            a & boost::serialization::make_nvp("jitter_max", s.jitter_max);
+            a & boost::serialization::make_nvp("jitter_histogram", s.jitter_histogram);
+        }
+    }
+}
+
+
+#endif /* ORO_THREADSTATISTICSTYPE_HPP_ */
@@ -75,17 +75,66 @@ namespace RTT
 
     TypeInfo* TypeInfoRepository::type( const std::string& name ) const
     {
-        MutexLock lock(type_lock);
-        map_t::const_iterator i = data.find( name );
-        if ( i == data.end() ) {
+        boost::shared_ptr<TypeLoader> loader;
+        {
+            MutexLock lock(type_lock);
+            map_t::const_iterator i = data.find( name );
+            if ( i != data.end() )
+                return i->second;
             // try alternate name replace / with dots:
             string tkname = "/" + boost::replace_all_copy(boost::replace_all_copy(name, string("."), "/"), "<","</");
             i = data.find( tkname );
-            if ( i == data.end())
+            if ( i != data.end() )
+                return i->second;
+            loader = takeDeferred( deferred_names, name );
+            if ( !loader )
+                loader = takeDeferred( deferred_names, tkname );
+            if ( !loader )
                 return 0;
         }
-        // found
-        return i->second;
+        // the loader calls addType(), so it may not hold type_lock.
+        log(Debug) << "Type '"<< name <<"' was deferred, loading it now." <<endlog();
+        (*loader)();
+        return type( name );
+    }
+
+    boost::shared_ptr<TypeInfoRepository::TypeLoader> TypeInfoRepository::takeDeferred( deferred_t& from, const std::string& name ) const
+    {
+        deferred_t::iterator it = from.find( name );
+        if ( it == from.end() )
+            return boost::shared_ptr<TypeLoader>();
+        boost::shared_ptr<TypeLoader> loader = it->second;
+        for( deferred_t::iterator d = deferred_names.begin(); d != deferred_names.end(); )
+            if ( d->second == loader )
+                deferred_names.erase( d++ );
+            else
+                ++d;
+        for( deferred_t::iterator d = deferred_ids.begin(); d != deferred_ids.end(); )
+            if ( d->second == loader )
+                deferred_ids.erase( d++ );
+            else
+                ++d;
+        return loader;
+    }
+
+    bool TypeInfoRepository::addDeferredTypes( const std::vector<std::string>& names,
+                                               const std::vector<std::string>& type_id_names,
+                                               const TypeLoader& loader )
+    {
+        MutexLock lock(type_lock);
+        boost::shared_ptr<TypeLoader> shared( new TypeLoader(loader) );
+        bool deferred = false;
+        for( vector<string>::const_iterator it = names.begin(); it != names.end(); ++it)
+            if ( data.count( *it ) == 0 ) {
+                deferred_names[ *it ] = shared;
+                deferred = true;
+            }
+        if ( !deferred )
+            return false;
+        for( vector<string>::const_iterator it = type_id_names.begin(); it != type_id_names.end(); ++it)
+            if ( !it->empty() )
+                deferred_ids[ *it ] = shared;
+        return true;
     }
 
     TypeInfoRepository::~TypeInfoRepository()
@@ -104,25 +153,39 @@ namespace RTT
     TypeInfo* TypeInfoRepository::getTypeById(TypeInfo::TypeId type_id) const {
       if (!type_id)
           return 0;
-      MutexLock lock(type_lock);
-      // Ask each type for its type id name.
-      map_t::const_iterator i = data.begin();
-      for (; i != data.end(); ++i){
-        if (i->second->getTypeId() && *(i->second->getTypeId()) == *type_id)
-          return i->second;
+      boost::shared_ptr<TypeLoader> loader;
+      {
+          MutexLock lock(type_lock);
+          // Ask each type for its type id name.
+          map_t::const_iterator i = data.begin();
+          for (; i != data.end(); ++i){
+            if (i->second->getTypeId() && *(i->second->getTypeId()) == *type_id)
+              return i->second;
+          }
+          loader = takeDeferred( deferred_ids, type_id->name() );
+          if ( !loader )
+              return 0;
       }
-      return 0;
+      (*loader)();
+      return getTypeById( type_id );
     }
 
     TypeInfo* TypeInfoRepository::getTypeById(const char * type_id_name) const {
-      // Ask each type for its type id name.
-      MutexLock lock(type_lock);
-      map_t::const_iterator i = data.begin();
-      for (; i != data.end(); ++i){
-        if (i->second->getTypeId() && i->second->getTypeId()->name() == type_id_name)
-          return i->second;
+      boost::shared_ptr<TypeLoader> loader;
+      {
+          // Ask each type for its type id name.
+          MutexLock lock(type_lock);
+          map_t::const_iterator i = data.begin();
+          for (; i != data.end(); ++i){
+            if (i->second->getTypeId() && i->second->getTypeId()->name() == type_id_name)
+              return i->second;
+          }
+          loader = takeDeferred( deferred_ids, type_id_name );
+          if ( !loader )
+              return 0;
       }
-      return 0;
+      (*loader)();
+      return getTypeById( type_id_name );
     }
 
     bool TypeInfoRepository::addType(TypeInfo* t)
@@ -42,6 +42,7 @@
 #include <vector>
 #include <string>
 #include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
 #include "TypeInfo.hpp"
 #include "TypeInfoGenerator.hpp"
 
@@ -61,6 +62,26 @@ namespace RTT
         typedef std::vector<TransportPlugin*> Transports;
         Transports transports;
         mutable os::Mutex type_lock;
+    public:
+        /**
+         * A function which installs the types announced with
+         * addDeferredTypes(), typically by loading a typekit.
+         */
+        typedef boost::function<bool(void)> TypeLoader;
+    private:
+        /**
+         * Deferred type names and type id names, all names announced in
+         * one addDeferredTypes() call share the same loader object.
+         */
+        typedef std::map<std::string, boost::shared_ptr<TypeLoader> > deferred_t;
+        mutable deferred_t deferred_names, deferred_ids;
+
+        /**
+         * Removes the loader of \a name and all the names sharing it
+         * from the deferred types. type_lock must be held.
+         * @return the loader or null if \a name was not deferred.
+         */
+        boost::shared_ptr<TypeLoader> takeDeferred( deferred_t& from, const std::string& name ) const;
     public:
         ~TypeInfoRepository();
         typedef boost::shared_ptr<TypeInfoRepository> shared_ptr;
@@ -126,6 +147,21 @@ namespace RTT
             return getTypeById( &typeid(T) );
         }
 
+        /**
+         * Announce types which will only be installed when they are first
+         * looked up with type() or getTypeById(). The \a loader is called
+         * at most once, without holding any lock of this repository, and
+         * must register the types with addType().
+         * @param names The type names (and aliases) that \a loader provides.
+         * @param type_id_names The typeid(T).name() of these types.
+         * @param loader The function that installs the types.
+         * @return false if all \a names are already known, in which case
+         * nothing was deferred.
+         */
+        bool addDeferredTypes( const std::vector<std::string>& names,
+                               const std::vector<std::string>& type_id_names,
+                               const TypeLoader& loader );
+
         /**
          * Call this function to add a new (network) transport
          * for Orocos types.
@@ -23,6 +23,7 @@
 
 #include <internal/AtomicQueue.hpp>
 #include <internal/AtomicMWSRQueue.hpp>
+#include <internal/PaddedMWSRQueue.hpp>
 
 #include <Activity.hpp>
 
@@ -30,7 +31,9 @@
 #include <base/Buffer.hpp>
 #include <internal/ListLockFree.hpp>
 #include <base/DataObject.hpp>
+#include <base/DataObjectSeqLock.hpp>
 #include <internal/TsPool.hpp>
+#include <internal/PaddedTsPool.hpp>
 //#include <internal/SortedList.hpp>
 
 #include <os/Thread.hpp>
@@ -115,6 +118,21 @@ public:
     }
 };
 
+class BuffersPaddedMWSRQueueTest
+{
+public:
+    PaddedMWSRQueue<Dummy*>* aqueue;
+
+    BuffersPaddedMWSRQueueTest()
+    {
+        aqueue = new PaddedMWSRQueue<Dummy*>(QS);
+    }
+    ~BuffersPaddedMWSRQueueTest(){
+        aqueue->clear();
+        delete aqueue;
+    }
+};
+
 class BuffersDataFlowTest
 {
 public:
@@ -133,6 +151,7 @@ public:
     DataObjectLocked<Dummy>* dlocked;
     DataObjectLockFree<Dummy>* dlockfree;
     DataObjectUnSync<Dummy>* dunsync;
+    DataObjectSeqLock<Dummy>* dseqlock;
 
     ThreadInterface* athread;
     ThreadInterface* bthread;
@@ -156,6 +175,7 @@ public:
         dlockfree = new DataObjectLockFree<Dummy>();
         dlocked   = new DataObjectLocked<Dummy>();
         dunsync   = new DataObjectUnSync<Dummy>();
+        dseqlock  = new DataObjectSeqLock<Dummy>();
 
         // defaults
         buffer = lockfree;
@@ -172,6 +192,7 @@ public:
         delete dlockfree;
         delete dlocked;
         delete dunsync;
+        delete dseqlock;
     }
 };
 
@@ -695,6 +716,129 @@ struct AQEater : public RunnableInterface
 };
 
 
+/**
+ * Writes samples with equal fields to a data object.
+ */
+struct DObjWriter : public RunnableInterface
+{
+    volatile bool stop;
+    DataObjectInterface<Dummy>* mdobj;
+    volatile int writes;
+    DObjWriter(DataObjectInterface<Dummy>* d) : stop(false), mdobj(d), writes(0) {}
+    bool initialize() {
+        stop = false;
+        return true;
+    }
+    void step() {
+        while (stop == false ) {
+            ++writes;
+            mdobj->Set( Dummy(writes, writes, writes) );
+        }
+    }
+    void finalize() {}
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
+
+/**
+ * A producer for the queue benchmark: sends \a count samples
+ * through a pool and a queue, like BufferLockFree does.
+ */
+template<class Q, class P>
+struct BenchProducer : public RunnableInterface
+{
+    Q* mq;
+    P* mpool;
+    int id;
+    int count;
+    BenchProducer(Q* q, P* p, int i, int c) : mq(q), mpool(p), id(i), count(c) {}
+    bool initialize() { return true; }
+    void step() {
+        for (int i = 0; i < count; ++i) {
+            Dummy* d;
+            while ( (d = mpool->allocate()) == 0 )
+                this->getActivity()->thread()->yield();
+            d->d1 = id;
+            d->d2 = i;
+            while ( mq->enqueue(d) == false )
+                this->getActivity()->thread()->yield();
+        }
+    }
+    void finalize() {}
+};
+
+/**
+ * The consumer for the queue benchmark: checks that the samples
+ * of each producer arrive complete and in order.
+ */
+template<class Q, class P>
+struct BenchConsumer : public RunnableInterface
+{
+    Q* mq;
+    P* mpool;
+    int total;
+    volatile int received;
+    int errors;
+    std::vector<int> next;
+    os::TimeService::ticks end;
+    BenchConsumer(Q* q, P* p, int producers, int t) : mq(q), mpool(p), total(t), received(0), errors(0), next(producers, 0), end(0) {}
+    bool initialize() { return true; }
+    void step() {
+        Dummy* d;
+        while ( received != total ) {
+            if ( mq->dequeue(d) ) {
+                if ( d->d2 != next[int(d->d1)]++ )
+                    ++errors;
+                mpool->deallocate(d);
+                ++received;
+            } else
+                this->getActivity()->thread()->yield();
+        }
+        end = os::TimeService::Instance()->getTicks();
+    }
+    void finalize() {}
+};
+
+/**
+ * Runs \a producers threads that each send \a count samples to
+ * one consumer thread and returns the elapsed time.
+ */
+template<class Q, class P>
+Seconds benchQueue(int producers, int count)
+{
+    Q q(64);
+    P pool(64);
+    BenchConsumer<Q,P> consumer(&q, &pool, producers, producers * count);
+    std::vector<BenchProducer<Q,P>*> workers;
+    std::vector<Activity*> threads;
+    for (int i = 0; i < producers; ++i) {
+        workers.push_back( new BenchProducer<Q,P>(&q, &pool, i, count) );
+        threads.push_back( new Activity(ORO_SCHED_OTHER, 0, 0.0, workers.back(), "BenchProducer") );
+    }
+    Activity cthread(ORO_SCHED_OTHER, 0, 0.0, &consumer, "BenchConsumer");
+
+    os::TimeService::ticks start = os::TimeService::Instance()->getTicks();
+    cthread.start();
+    for (int i = 0; i < producers; ++i)
+        threads[i]->start();
+    while ( consumer.received != consumer.total )
+        usleep(1000);
+    cthread.stop();
+    Seconds elapsed = os::TimeService::ticks2nsecs(consumer.end - start) / 1e9;
+
+    for (int i = 0; i < producers; ++i) {
+        threads[i]->stop();
+        delete threads[i];
+        delete workers[i];
+    }
+    BOOST_CHECK_EQUAL( consumer.errors, 0 );
+    BOOST_CHECK( q.isEmpty() );
+    BOOST_CHECK_EQUAL( pool.size(), 64u );
+    return elapsed;
+}
+
 BOOST_FIXTURE_TEST_SUITE( BuffersAtomicTestSuite, BuffersAQueueTest )
 
 BOOST_AUTO_TEST_CASE( testAtomicQueue )
@@ -785,6 +929,51 @@ BOOST_AUTO_TEST_CASE( testAtomicMWSRQueue )
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_FIXTURE_TEST_SUITE( BuffersPaddedMWSRQueueTestSuite, BuffersPaddedMWSRQueueTest )
+
+BOOST_AUTO_TEST_CASE( testPaddedMWSRQueue )
+{
+    /**
+     * Single Threaded test for PaddedMWSRQueue.
+     */
+    Dummy* d = new Dummy();
+    Dummy* c = d;
+
+    BOOST_REQUIRE_EQUAL( PaddedMWSRQueue<Dummy*>::size_type(QS), aqueue->capacity() );
+    BOOST_REQUIRE_EQUAL( PaddedMWSRQueue<Dummy*>::size_type(0), aqueue->size() );
+    BOOST_CHECK( aqueue->isFull() == false );
+    BOOST_CHECK( aqueue->isEmpty() == true );
+    BOOST_CHECK( aqueue->dequeue(c) == false );
+    BOOST_CHECK( c == d );
+    BOOST_CHECK( aqueue->enqueue( 0 ) == false );
+
+    // wrap around the slots a few times.
+    for ( int j = 0; j < 3; ++j) {
+        for ( int i = 0; i < QS; ++i) {
+            BOOST_CHECK( aqueue->enqueue( d + i ) == true);
+            BOOST_REQUIRE_EQUAL( PaddedMWSRQueue<Dummy*>::size_type(i+1), aqueue->size() );
+        }
+        BOOST_CHECK( aqueue->isFull() == true );
+        BOOST_CHECK( aqueue->isEmpty() == false );
+        BOOST_CHECK( aqueue->enqueue( d ) == false );
+        BOOST_REQUIRE_EQUAL( PaddedMWSRQueue<Dummy*>::size_type(QS), aqueue->size() );
+        BOOST_CHECK( aqueue->front() == d );
+
+        for ( int i = 0; i < QS ; ++i) {
+            BOOST_CHECK( aqueue->dequeue( c ) == true);
+            BOOST_CHECK( c == d + i );
+            BOOST_REQUIRE_EQUAL( PaddedMWSRQueue<Dummy*>::size_type(QS - 1 - i), aqueue->size() );
+        }
+        BOOST_CHECK( aqueue->isFull() == false );
+        BOOST_CHECK( aqueue->isEmpty() == true );
+        BOOST_CHECK( aqueue->dequeue(c) == false );
+    }
+
+    delete d;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_FIXTURE_TEST_SUITE( BuffersDataFlowTestSuite, BuffersDataFlowTest )
 
 BOOST_AUTO_TEST_CASE( testBufLockFree )
@@ -829,6 +1018,33 @@ BOOST_AUTO_TEST_CASE( testDObjUnSync )
     testDObj();
 }
 
+BOOST_AUTO_TEST_CASE( testDObjSeqLock )
+{
+    BOOST_CHECK( is_seqlock_copyable<Dummy>::value );
+    BOOST_CHECK( !is_seqlock_copyable< std::vector<Dummy> >::value );
+    dataobj = dseqlock;
+    testDObj();
+
+    // readers must never see a partially written sample.
+    DObjWriter writer(dseqlock);
+    {
+        boost::scoped_ptr<Activity> wthread( new Activity(ORO_SCHED_OTHER, 0, 0.0, &writer, "DObjWriter") );
+        wthread->start();
+        while ( writer.writes == 0 )
+            usleep(1000);
+        Dummy d;
+        int torn = 0;
+        for (int i = 0; i < 1000000; ++i) {
+            dseqlock->Get(d);
+            if ( d.d1 != d.d2 || d.d1 != d.d3 )
+                ++torn;
+        }
+        wthread->stop();
+        BOOST_CHECK_EQUAL( torn, 0 );
+    }
+    BOOST_CHECK( writer.writes > 0 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_FIXTURE_TEST_SUITE( BuffersMPoolTestSuite, BuffersMPoolTest )
 
@@ -877,6 +1093,30 @@ BOOST_AUTO_TEST_CASE( testMemoryPool )
     BOOST_CHECK_EQUAL( mpool->size(), QS);
 }
 
+BOOST_AUTO_TEST_CASE( testPaddedMemoryPool )
+{
+    // larger than what fits in the 16 bit indexes of TsPool.
+    PaddedTsPool<Dummy>::size_type sz = 70000;
+    if ( PaddedTsPool<Dummy>::max_capacity() < sz )
+        sz = PaddedTsPool<Dummy>::max_capacity();
+    PaddedTsPool<Dummy> pool(sz, Dummy(1,2,3));
+    BOOST_REQUIRE_EQUAL( sz, pool.capacity() );
+    BOOST_CHECK_EQUAL( sz, pool.size() );
+
+    std::vector<Dummy*> mpv;
+    for (PaddedTsPool<Dummy>::size_type i = 0; i < sz; ++i ) {
+        mpv.push_back( pool.allocate() );
+        BOOST_REQUIRE( mpv.back() );
+        BOOST_CHECK( *mpv.back() == Dummy(1,2,3) );
+    }
+    BOOST_CHECK_EQUAL( pool.size(), 0 );
+    BOOST_CHECK_EQUAL( pool.allocate(), (Dummy*)0 );
+    for (PaddedTsPool<Dummy>::size_type i = 0; i < sz; ++i )
+        BOOST_CHECK( pool.deallocate( mpv[i] ) );
+    BOOST_CHECK_EQUAL( pool.size(), sz );
+    BOOST_CHECK( pool.deallocate( 0 ) == false );
+}
+
 #if 0
 BOOST_AUTO_TEST_CASE( testSortedList )
 {
@@ -1156,4 +1396,20 @@ BOOST_AUTO_TEST_CASE( testAtomicMWSRQueue )
     delete eater;
 }
 #endif
+
+/**
+ * Compares the throughput of AtomicMWSRQueue/TsPool against
+ * PaddedMWSRQueue/PaddedTsPool with 1 to 16 producers.
+ */
+BOOST_AUTO_TEST_CASE( testMWSRQueueBenchmark )
+{
+    const int count = 5000;
+    for (int producers = 1; producers <= 16; producers *= 2) {
+        Seconds atomic = benchQueue< AtomicMWSRQueue<Dummy*>, TsPool<Dummy> >(producers, count);
+        Seconds padded = benchQueue< PaddedMWSRQueue<Dummy*>, PaddedTsPool<Dummy> >(producers, count);
+        BOOST_TEST_MESSAGE( "Producers: " << producers << " Samples: " << producers * count
+                            << " AtomicMWSRQueue/TsPool: " << atomic << "s"
+                            << " PaddedMWSRQueue/PaddedTsPool: " << padded << "s" );
+    }
+}
 BOOST_AUTO_TEST_SUITE_END()
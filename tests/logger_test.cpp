@@ -22,6 +22,7 @@
 #include "logger_test.hpp"
 
 #include <iostream>
+#include <sstream>
 #include <boost/scoped_ptr.hpp>
 #include <Activity.hpp>
 #include <base/RunnableInterface.hpp>
@@ -118,4 +119,49 @@ BOOST_AUTO_TEST_CASE( testThreadLog )
 
 }
 
+BOOST_AUTO_TEST_CASE( testAsyncLog )
+{
+    std::stringstream out;
+    Logger::LogLevel ll = logger->getLogLevel();
+    logger->setStdStream( out );
+    logger->setLogLevel( Logger::Info );
+
+    BOOST_CHECK( !logger->setAsynchronous(true, 0) );
+    BOOST_REQUIRE( logger->setAsynchronous(true, 4) );
+    BOOST_CHECK( logger->isAsynchronous() );
+    {
+        Logger::In in("ASYNC");
+        BOOST_CHECK_EQUAL( logger->getLogModule(), "ASYNC" );
+        log(Info) << "Message " << 1 << " from the test thread" << endlog();
+        log(Debug) << "Filtered message" << endlog();
+    }
+
+    // messages from other threads are kept apart.
+    TestLog run;
+    Activity t(ORO_SCHED_OTHER, 0, 0.01, &run, "AsyncLog");
+    BOOST_CHECK( t.start() );
+    usleep(100000);
+    BOOST_CHECK( t.stop() );
+    BOOST_CHECK( out.str().find("[ Info   ][ASYNC] Message 1 from the test thread") != std::string::npos );
+    BOOST_CHECK( out.str().find("[TLOG] Hello this is the world") != std::string::npos );
+    BOOST_CHECK( out.str().find("Filtered message") == std::string::npos );
+
+    // overflowing the four records of this thread.
+    unsigned int dropped = logger->getDroppedRecords();
+    for (int i = 0; i != 100; ++i)
+        log(Info) << "Overflow " << i << endlog();
+    BOOST_CHECK( logger->getDroppedRecords() > dropped );
+
+    // the pending records are written out when returning to synchronous mode.
+    BOOST_CHECK( logger->setAsynchronous(false) );
+    BOOST_CHECK( !logger->isAsynchronous() );
+    BOOST_CHECK( out.str().find("Overflow 0") != std::string::npos );
+
+    log(Info) << "Synchronous again" << endlog();
+    BOOST_CHECK( out.str().find("Synchronous again") != std::string::npos );
+
+    logger->setLogLevel( ll );
+    logger->setStdStream( std::cerr );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
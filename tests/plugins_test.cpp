@@ -21,6 +21,8 @@
 #include "unit.hpp"
 
 #include <boost/filesystem.hpp>
+#include <fstream>
+#include <cstdio>
 #include "TaskContext.hpp"
 #include "plugin/Plugin.hpp"
 #include "plugin/PluginLoader.hpp"
@@ -240,5 +242,33 @@ BOOST_AUTO_TEST_CASE( testServicePlugin )
 
 }
 
+/** The plugin cache is written after a scan and used by the next loader.
+ */
+BOOST_AUTO_TEST_CASE( testPluginCache )
+{
+    std::string cache = "plugins_test.cache";
+    std::remove( cache.c_str() );
+    {
+        PluginLoader pl;
+        pl.setPluginCache( cache );
+        BOOST_REQUIRE( pl.loadTypekit("testproject",".;..") );
+        BOOST_CHECK( pl.isLoaded("TypesPluginTest") );
+    }
+    std::ifstream in( cache.c_str() );
+    BOOST_REQUIRE( in );
+    std::string contents( (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>() );
+    BOOST_CHECK( contents.find("TypesPluginTest") != std::string::npos );
+    {
+        // a typekit which registers no types is never deferred:
+        PluginLoader pl;
+        pl.setPluginCache( cache );
+        pl.setLazyTypekits( true );
+        BOOST_REQUIRE( pl.loadTypekit("testproject",".;..") );
+        BOOST_CHECK( pl.isLoaded("TypesPluginTest") );
+        BOOST_CHECK_EQUAL( pl.getPluginCache(), cache );
+    }
+    std::remove( cache.c_str() );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -21,6 +21,8 @@
 #include <OutputPort.hpp>
 
 #include <TaskContext.hpp>
+#include <Activity.hpp>
+#include <os/TimeService.hpp>
 #include <extras/SlaveActivity.hpp>
 #include <extras/SequentialActivity.hpp>
 #include <extras/SimulationActivity.hpp>
@@ -39,18 +41,69 @@ class EventPortsTC : public TaskContext
 public:
     bool had_event;
     int  nb_events;
+    std::vector<InputPortInterface*> fired;
     EventPortsTC(): TaskContext("eptc") { resetStats(); }
     void updateHook()
     {
         nb_events++;
         had_event = true;
+        fired = getFiredPorts();
     }
     void resetStats() {
         nb_events = 0;
         had_event = false;
+        fired.clear();
     }
 };
 
+/**
+ * Writes to a port as fast as possible until stopped.
+ */
+struct PortWriter : public RunnableInterface
+{
+    volatile bool stop;
+    OutputPort<double>& port;
+    volatile int writes;
+    PortWriter(OutputPort<double>& p) : stop(false), port(p), writes(0) {}
+    bool initialize() {
+        stop = false; writes = 0;
+        return true;
+    }
+    void step() {
+        while (stop == false) {
+            port.write( double(writes) );
+            ++writes;
+        }
+    }
+    void finalize() {}
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
+
+/**
+ * A sample which counts how many times it is copied.
+ */
+struct CopyCounted
+{
+    static int copies;
+    std::vector<double> data;
+    CopyCounted() {}
+    CopyCounted(CopyCounted const& orig) : data(orig.data) { ++copies; }
+    CopyCounted& operator=(CopyCounted const& orig) { data = orig.data; ++copies; return *this; }
+};
+int CopyCounted::copies = 0;
+
+/**
+ * A channel which is invalidated on each write.
+ */
+struct FailingChannel : public base::ChannelElement<double>
+{
+    virtual bool data_sample(param_t) { return true; }
+    virtual bool write(param_t) { return false; }
+};
+
 /**
  * Fixture.
  */
@@ -353,6 +406,95 @@ BOOST_AUTO_TEST_CASE(testPortOneWriterThreeReaders)
     BOOST_CHECK_EQUAL( rp3.read(value), NoData );
 }
 
+BOOST_AUTO_TEST_CASE(testPortSharedConnections)
+{
+    OutputPort<int> wp("W");
+    InputPort<int> rp1("R1");
+    InputPort<int> rp2("R2");
+    InputPort<int> rp3("R3");
+    InputPort<int> rp4("R4");
+
+    ConnPolicy data = ConnPolicy::data(ConnPolicy::LOCK_FREE, false);
+    data.shared = true;
+    ConnPolicy buffer = ConnPolicy::buffer(4);
+    buffer.shared = true;
+
+    BOOST_REQUIRE( wp.createConnection(rp1, data) );
+    BOOST_REQUIRE( wp.createConnection(rp2, buffer) );
+    BOOST_REQUIRE( wp.createConnection(rp3, data) );
+    BOOST_REQUIRE( wp.createConnection(rp4, buffer) );
+
+    // the data connections share one storage, the buffers another.
+    std::list<internal::ConnectionManager::ChannelDescriptor> channels = wp.getManager()->getChannels();
+    BOOST_REQUIRE_EQUAL( channels.size(), 4 );
+    std::list<internal::ConnectionManager::ChannelDescriptor>::iterator it = channels.begin();
+    internal::ChannelSharedElement<int>* shared1 = dynamic_cast< internal::ChannelSharedElement<int>* >( (it++)->get<1>()->getOutput().get() );
+    internal::ChannelSharedElement<int>* shared2 = dynamic_cast< internal::ChannelSharedElement<int>* >( (it++)->get<1>()->getOutput().get() );
+    internal::ChannelSharedElement<int>* shared3 = dynamic_cast< internal::ChannelSharedElement<int>* >( (it++)->get<1>()->getOutput().get() );
+    internal::ChannelSharedElement<int>* shared4 = dynamic_cast< internal::ChannelSharedElement<int>* >( (it++)->get<1>()->getOutput().get() );
+    BOOST_REQUIRE( shared1 && shared2 && shared3 && shared4 );
+    BOOST_CHECK( shared1->getStorage() == shared3->getStorage() );
+    BOOST_CHECK( shared2->getStorage() == shared4->getStorage() );
+    BOOST_CHECK( shared1->getStorage() != shared2->getStorage() );
+
+    int value = 0;
+    BOOST_CHECK_EQUAL( rp1.read(value), NoData );
+    BOOST_CHECK_EQUAL( rp2.read(value), NoData );
+
+    wp.write(10);
+    wp.write(15);
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+    BOOST_CHECK_EQUAL(15, value);
+    BOOST_CHECK_EQUAL( rp1.read(value), OldData );
+    BOOST_CHECK_EQUAL(15, value);
+    BOOST_CHECK_EQUAL( rp2.read(value), NewData );
+    BOOST_CHECK_EQUAL(10, value);
+
+    wp.write(20);
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+    BOOST_CHECK_EQUAL(20, value);
+    BOOST_CHECK_EQUAL( rp3.read(value), NewData );
+    BOOST_CHECK_EQUAL(20, value);
+    BOOST_CHECK_EQUAL( rp3.read(value), OldData );
+
+    // rp4 did not read yet, so the buffer is full after the fourth sample.
+    wp.write(25);
+    wp.write(30);
+    BOOST_CHECK_EQUAL( rp4.read(value), NewData );
+    BOOST_CHECK_EQUAL(10, value);
+    BOOST_CHECK_EQUAL( rp4.read(value), NewData );
+    BOOST_CHECK_EQUAL(15, value);
+    BOOST_CHECK_EQUAL( rp4.read(value), NewData );
+    BOOST_CHECK_EQUAL(20, value);
+    BOOST_CHECK_EQUAL( rp4.read(value), NewData );
+    BOOST_CHECK_EQUAL(25, value);
+    BOOST_CHECK_EQUAL( rp4.read(value), OldData );
+    BOOST_CHECK_EQUAL(25, value);
+    BOOST_CHECK_EQUAL( rp2.read(value), NewData );
+    BOOST_CHECK_EQUAL(15, value);
+
+    // a shared connection added later only sees new samples.
+    InputPort<int> rp5("R5");
+    BOOST_REQUIRE( wp.createConnection(rp5, data) );
+    BOOST_CHECK_EQUAL( rp5.read(value), NoData );
+    wp.write(35);
+    BOOST_CHECK_EQUAL( rp5.read(value), NewData );
+    BOOST_CHECK_EQUAL(35, value);
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+    BOOST_CHECK_EQUAL(35, value);
+
+    rp1.disconnect();
+    wp.write(40);
+    BOOST_CHECK_EQUAL( rp1.read(value), NoData );
+    BOOST_CHECK_EQUAL( rp3.read(value), NewData );
+    BOOST_CHECK_EQUAL(40, value);
+
+    wp.disconnect();
+    BOOST_CHECK( !wp.connected() );
+    BOOST_CHECK_EQUAL( rp3.read(value), NoData );
+    BOOST_CHECK_EQUAL( rp4.read(value), NoData );
+}
+
 BOOST_AUTO_TEST_CASE(testPortThreeWritersOneReader)
 {
     OutputPort<int> wp1("W1");
@@ -491,6 +633,85 @@ BOOST_AUTO_TEST_CASE( testPortObjects)
     BOOST_CHECK( tc->ports()->getPort("Write") == 0 );
 }
 
+BOOST_AUTO_TEST_CASE( testConnectionStatistics )
+{
+    OutputPort<double> wp1("Write");
+    InputPort<double>  rp1("ReadData");
+    InputPort<double>  rp2("ReadBuffer");
+    InputPort<double>  rp3("ReadCircular");
+    tc->ports()->addPort( wp1 );
+    tc->ports()->addPort( rp1 );
+    tc->ports()->addPort( rp2 );
+    tc->ports()->addPort( rp3 );
+
+    BOOST_REQUIRE( wp1.createConnection( rp1, ConnPolicy::data() ) );
+    BOOST_REQUIRE( wp1.createConnection( rp2, ConnPolicy::buffer(2) ) );
+    ConnPolicy circular = ConnPolicy::buffer(2);
+    circular.type = ConnPolicy::CIRCULAR_BUFFER;
+    BOOST_REQUIRE( wp1.createConnection( rp3, circular ) );
+
+    double value = 0;
+    BOOST_CHECK_EQUAL( rp2.read(value), NoData );
+    for (int i = 0; i != 3; ++i)
+        wp1.write( i );
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+    BOOST_CHECK_EQUAL( rp1.read(value), OldData );
+
+    std::vector<ConnectionStatistics> stats = rp1.getConnectionStatistics();
+    BOOST_REQUIRE_EQUAL( stats.size(), 1u );
+    BOOST_CHECK_EQUAL( stats[0].port, "ReadData" );
+    BOOST_CHECK_EQUAL( stats[0].policy.type, ConnPolicy::DATA );
+    BOOST_CHECK_EQUAL( stats[0].writes, 3u );
+    BOOST_CHECK_EQUAL( stats[0].drops, 0u );
+    BOOST_CHECK_EQUAL( stats[0].overwrites, 2u );
+    BOOST_CHECK_EQUAL( stats[0].reads, 2u );
+    BOOST_CHECK_EQUAL( stats[0].new_data, 1u );
+    BOOST_CHECK_EQUAL( stats[0].old_data, 1u );
+    BOOST_CHECK( stats[0].last_write > 0.0 );
+    BOOST_CHECK( stats[0].last_read >= stats[0].last_write );
+
+    stats = rp2.getConnectionStatistics();
+    BOOST_REQUIRE_EQUAL( stats.size(), 1u );
+    BOOST_CHECK_EQUAL( stats[0].writes, 3u );
+    BOOST_CHECK_EQUAL( stats[0].drops, 1u );
+    BOOST_CHECK_EQUAL( stats[0].overwrites, 0u );
+    BOOST_CHECK_EQUAL( stats[0].high_water_mark, 2u );
+    BOOST_CHECK_EQUAL( stats[0].no_data, 1u );
+
+    stats = rp3.getConnectionStatistics();
+    BOOST_REQUIRE_EQUAL( stats.size(), 1u );
+    BOOST_CHECK_EQUAL( stats[0].writes, 3u );
+    BOOST_CHECK_EQUAL( stats[0].drops, 0u );
+    BOOST_CHECK_EQUAL( stats[0].overwrites, 1u );
+    BOOST_CHECK_EQUAL( stats[0].high_water_mark, 2u );
+    BOOST_CHECK_EQUAL( stats[0].reads, 0u );
+
+    // the output port sees the same storage elements:
+    stats = wp1.getConnectionStatistics();
+    BOOST_REQUIRE_EQUAL( stats.size(), 3u );
+    BOOST_CHECK_EQUAL( stats[1].port, "Write" );
+    BOOST_CHECK_EQUAL( stats[1].drops, 1u );
+
+    // through the port object and for the whole component:
+    OperationCaller<std::vector<ConnectionStatistics>(void)> getstats = tc->provides("ReadBuffer")->getOperation("getConnectionStatistics");
+    BOOST_REQUIRE( getstats.ready() );
+    BOOST_CHECK_EQUAL( getstats().size(), 1u );
+    BOOST_CHECK_EQUAL( getstats()[0].drops, 1u );
+    BOOST_CHECK_EQUAL( tc->getConnectionStatistics().size(), 6u );
+
+    tc->resetConnectionStatistics();
+    stats = rp2.getConnectionStatistics();
+    BOOST_REQUIRE_EQUAL( stats.size(), 1u );
+    BOOST_CHECK_EQUAL( stats[0].writes, 0u );
+    BOOST_CHECK_EQUAL( stats[0].drops, 0u );
+    BOOST_CHECK_EQUAL( stats[0].last_write, 0.0 );
+
+    tc->ports()->removePort("Write");
+    tc->ports()->removePort("ReadData");
+    tc->ports()->removePort("ReadBuffer");
+    tc->ports()->removePort("ReadCircular");
+}
+
 #ifdef ORO_SIGNALLING_PORTS
 BOOST_AUTO_TEST_CASE(testPortSignalling)
 {
@@ -625,6 +846,59 @@ BOOST_AUTO_TEST_CASE(testEventPortSignalling)
     tce->ports()->removePort( rp1.getName() );
 }
 
+BOOST_AUTO_TEST_CASE(testEventPortCoalescing)
+{
+    OutputPort<double> wp1("Write1");
+    OutputPort<double> wp2("Write2");
+    InputPort<double>  rp1("Read1");
+    InputPort<double>  rp2("Read2");
+    InputPort<double>  rp3("Read3");
+
+    // a slave without master is only executed when we say so:
+    EventPortsTC tcs;
+    tcs.setActivity( new SlaveActivity() );
+    tcs.addEventPort(rp1, boost::bind(&PortsTestFixture::new_data_listener, this, _1) );
+    tcs.addEventPort(rp2);
+    tcs.addEventPort(rp3);
+    BOOST_REQUIRE( wp1.createConnection(rp1, ConnPolicy::buffer(200)) );
+    BOOST_REQUIRE( wp2.createConnection(rp2, ConnPolicy::data()) );
+    BOOST_REQUIRE( tcs.start() );
+    tcs.getActivity()->execute();
+    tcs.resetStats();
+
+    // more signals than the old 64 element port queue could hold:
+    signalled_port = 0;
+    for (int i = 0; i != 100; ++i) {
+        wp1.write(0.1);
+        wp2.write(0.2);
+    }
+    BOOST_CHECK( 0 == signalled_port );
+    BOOST_CHECK( tcs.getActivity()->execute() );
+    BOOST_CHECK_EQUAL( tcs.nb_events, 1 );
+    BOOST_CHECK( &rp1 == signalled_port );
+    BOOST_REQUIRE_EQUAL( tcs.fired.size(), 2u );
+    BOOST_CHECK( tcs.fired[0] == &rp1 );
+    BOOST_CHECK( tcs.fired[1] == &rp2 );
+
+    // nothing fired since the previous cycle:
+    tcs.resetStats();
+    signalled_port = 0;
+    BOOST_CHECK( tcs.getActivity()->execute() );
+    BOOST_CHECK( tcs.fired.empty() );
+    BOOST_CHECK( 0 == signalled_port );
+
+    wp2.write(0.3);
+    BOOST_CHECK( tcs.getActivity()->execute() );
+    BOOST_REQUIRE_EQUAL( tcs.fired.size(), 1u );
+    BOOST_CHECK( tcs.fired[0] == &rp2 );
+    BOOST_CHECK( 0 == signalled_port );
+
+    tcs.stop();
+    tcs.ports()->removePort( rp1.getName() );
+    tcs.ports()->removePort( rp2.getName() );
+    tcs.ports()->removePort( rp3.getName() );
+}
+
 BOOST_AUTO_TEST_CASE(testPlainPortNotSignalling)
 {
     OutputPort<double> wp1("Write");
@@ -678,5 +952,249 @@ BOOST_AUTO_TEST_CASE(testPortDataSource)
     BOOST_CHECK_EQUAL(20, source->value());
 }
 
+BOOST_AUTO_TEST_CASE(testPortLoan)
+{
+    OutputPort<CopyCounted> wp("W", false);
+    InputPort<CopyCounted> rp1("R1");
+    InputPort<CopyCounted> rp2("R2");
+    InputPort<CopyCounted> rp3("R3");
+    CopyCounted const* loaned = 0;
+
+    ConnPolicy shared = ConnPolicy::buffer(4);
+    shared.shared = true;
+    BOOST_REQUIRE( wp.createConnection(rp1, shared) );
+    BOOST_REQUIRE( wp.createConnection(rp2, shared) );
+
+    // the loaned sample is published without copies.
+    CopyCounted::copies = 0;
+    wp.loan().data.assign(100, 1.0);
+    wp.commit();
+    BOOST_CHECK_EQUAL( rp1.readLoaned(loaned), NewData );
+    BOOST_REQUIRE( loaned );
+    BOOST_CHECK_EQUAL( loaned->data.size(), 100 );
+    BOOST_CHECK_EQUAL( rp2.readLoaned(loaned), NewData );
+    BOOST_CHECK_EQUAL( loaned->data.size(), 100 );
+    BOOST_CHECK_EQUAL( rp2.readLoaned(loaned), OldData );
+    BOOST_CHECK_EQUAL( loaned->data.size(), 100 );
+    BOOST_CHECK_EQUAL( CopyCounted::copies, 0 );
+
+    // a plain write copies once, a plain read once more.
+    CopyCounted sample;
+    sample.data.assign(50, 2.0);
+    wp.write(sample);
+    BOOST_CHECK_EQUAL( CopyCounted::copies, 1 );
+    BOOST_CHECK_EQUAL( rp1.read(sample), NewData );
+    BOOST_CHECK_EQUAL( CopyCounted::copies, 2 );
+    BOOST_CHECK_EQUAL( rp2.readLoaned(loaned), NewData );
+    BOOST_CHECK_EQUAL( loaned->data.size(), 50 );
+    BOOST_CHECK_EQUAL( CopyCounted::copies, 2 );
+
+    // a private buffer connection copies on commit, but not on readLoaned.
+    BOOST_REQUIRE( wp.createConnection(rp3, ConnPolicy::buffer(4)) );
+    CopyCounted::copies = 0;
+    wp.loan().data.assign(10, 3.0);
+    wp.commit();
+    BOOST_CHECK_EQUAL( CopyCounted::copies, 1 );
+    BOOST_CHECK_EQUAL( rp3.readLoaned(loaned), NewData );
+    BOOST_CHECK_EQUAL( loaned->data.size(), 10 );
+    BOOST_CHECK_EQUAL( rp1.readLoaned(loaned), NewData );
+    BOOST_CHECK_EQUAL( loaned->data.size(), 10 );
+    BOOST_CHECK_EQUAL( CopyCounted::copies, 1 );
+
+    // commit without loan does nothing.
+    wp.commit();
+    BOOST_CHECK_EQUAL( rp1.readLoaned(loaned), OldData );
+
+    wp.disconnect();
+    BOOST_CHECK_EQUAL( rp1.readLoaned(loaned), NoData );
+}
+
+/**
+ * Compares write()/read() with loan()/commit()/readLoaned() for large samples
+ * and one writer with four readers.
+ */
+BOOST_AUTO_TEST_CASE(testPortLoanBenchmark)
+{
+    const int samples = 200;
+    OutputPort<CopyCounted> wp("W", false);
+    InputPort<CopyCounted> rp[4];
+    CopyCounted sample;
+    sample.data.resize(100000);
+    CopyCounted const* loaned = 0;
+
+    ConnPolicy shared = ConnPolicy::data();
+    shared.shared = true;
+    for (int i = 0; i != 4; ++i)
+        BOOST_REQUIRE( wp.createConnection(rp[i], ConnPolicy::data()) );
+    CopyCounted::copies = 0;
+    os::TimeService::ticks start = os::TimeService::Instance()->getTicks();
+    for (int s = 0; s != samples; ++s) {
+        wp.write(sample);
+        for (int i = 0; i != 4; ++i)
+            rp[i].read(sample);
+    }
+    os::TimeService::Seconds copied = os::TimeService::Instance()->secondsSince(start);
+    int copies = CopyCounted::copies;
+    wp.disconnect();
+
+    for (int i = 0; i != 4; ++i)
+        BOOST_REQUIRE( wp.createConnection(rp[i], shared) );
+    CopyCounted::copies = 0;
+    start = os::TimeService::Instance()->getTicks();
+    for (int s = 0; s != samples; ++s) {
+        CopyCounted& out = wp.loan();
+        out.data.resize(100000);
+        out.data[0] = s;
+        wp.commit();
+        for (int i = 0; i != 4; ++i)
+            BOOST_CHECK_EQUAL( rp[i].readLoaned(loaned), NewData );
+    }
+    os::TimeService::Seconds loaning = os::TimeService::Instance()->secondsSince(start);
+
+    BOOST_TEST_MESSAGE( "write/read: " << copies / samples << " copies and " << 1e6 * copied / samples << " us per sample" );
+    BOOST_TEST_MESSAGE( "loan/commit/readLoaned: " << CopyCounted::copies / samples << " copies and " << 1e6 * loaning / samples << " us per sample" );
+    BOOST_CHECK_EQUAL( copies, 8 * samples );
+    BOOST_CHECK_EQUAL( CopyCounted::copies, 0 );
+    wp.disconnect();
+}
+
+BOOST_AUTO_TEST_CASE(testPortBatch)
+{
+    OutputPort<double> wp("W");
+    InputPort<double> rp1("R1");
+    InputPort<double> rp2("R2");
+    InputPort<double> rp3("R3");
+    std::vector<double> batch, result;
+    double value = 0;
+    for (int i = 1; i != 6; ++i)
+        batch.push_back(i);
+
+    // a buffer stores what fits and is drained at once.
+    BOOST_REQUIRE( wp.createConnection(rp1, ConnPolicy::buffer(4)) );
+    BOOST_CHECK_EQUAL( rp1.readAll(result), NoData );
+    wp.writeBatch(batch);
+    BOOST_CHECK_EQUAL( rp1.readAll(result), NewData );
+    BOOST_REQUIRE_EQUAL( result.size(), 4 );
+    for (int i = 0; i != 4; ++i)
+        BOOST_CHECK_EQUAL( result[i], i + 1 );
+    BOOST_CHECK_EQUAL( rp1.readAll(result), OldData );
+    BOOST_CHECK( result.empty() );
+    BOOST_CHECK_EQUAL( rp1.read(value), OldData );
+    BOOST_CHECK_EQUAL( value, 4 );
+
+    // a data connection only keeps the last sample.
+    BOOST_REQUIRE( wp.createConnection(rp2, ConnPolicy::data()) );
+    wp.writeBatch(batch);
+    BOOST_CHECK_EQUAL( rp2.readAll(result), NewData );
+    BOOST_REQUIRE_EQUAL( result.size(), 1 );
+    BOOST_CHECK_EQUAL( result[0], 5 );
+    BOOST_CHECK_EQUAL( rp1.readAll(result), NewData );
+    BOOST_CHECK_EQUAL( result.size(), 4 );
+
+    // shared connections store the batch once for all readers.
+    wp.disconnect();
+    ConnPolicy shared = ConnPolicy::buffer(8);
+    shared.shared = true;
+    BOOST_REQUIRE( wp.createConnection(rp1, shared) );
+    BOOST_REQUIRE( wp.createConnection(rp3, shared) );
+    wp.writeBatch(batch);
+    wp.write(6.0);
+    BOOST_CHECK_EQUAL( rp1.readAll(result), NewData );
+    BOOST_CHECK_EQUAL( result.size(), 6 );
+    BOOST_CHECK_EQUAL( rp3.readAll(result), NewData );
+    BOOST_REQUIRE_EQUAL( result.size(), 6 );
+    BOOST_CHECK_EQUAL( result[5], 6 );
+
+    // an empty batch writes nothing.
+    wp.writeBatch( std::vector<double>() );
+    BOOST_CHECK_EQUAL( rp1.readAll(result), OldData );
+    wp.disconnect();
+}
+
+BOOST_AUTO_TEST_CASE(testPortFailedWriteRemovesConnection)
+{
+    OutputPort<double> wp("W");
+    InputPort<double>  rp("R");
+    double val = -1;
+
+    BOOST_REQUIRE( wp.createConnection(rp) );
+    base::ChannelElementBase::shared_ptr failing = new FailingChannel();
+    BOOST_REQUIRE( wp.addConnection( new StreamConnID("failing"), ConnFactory::buildChannelInput(wp, new StreamConnID("failing"), failing), ConnPolicy() ) );
+    BOOST_CHECK_EQUAL( wp.getManager()->getChannels().size(), 2 );
+
+    // the invalidated channel is skipped from then on, the other one keeps working.
+    wp.write(1.0);
+    BOOST_CHECK_EQUAL( wp.getManager()->getChannels().size(), 1 );
+    BOOST_CHECK_EQUAL( rp.read(val), NewData );
+    BOOST_CHECK_EQUAL( val, 1.0 );
+    wp.write(2.0);
+    BOOST_CHECK_EQUAL( rp.read(val), NewData );
+    BOOST_CHECK_EQUAL( val, 2.0 );
+    BOOST_CHECK( wp.connected() );
+
+    rp.disconnect();
+    BOOST_CHECK( !wp.connected() );
+    BOOST_CHECK( wp.getManager()->getChannels().empty() );
+}
+
+BOOST_AUTO_TEST_CASE(testPortConnectWhileWriting)
+{
+    OutputPort<double> wp1("Write");
+    PortWriter writer(wp1);
+    std::vector< InputPort<double>* > readers;
+    double val = -1;
+
+    Activity athread(ORO_SCHED_OTHER, 0, 0, &writer, "PortWriter");
+    BOOST_REQUIRE( athread.start() );
+
+    // the connection table is replaced while the writer thread iterates it.
+    for (int i = 0; i < 20; ++i) {
+        readers.push_back( new InputPort<double>("Read") );
+        BOOST_REQUIRE( wp1.createConnection( *readers.back(), i % 2 ? ConnPolicy::data() : ConnPolicy::buffer(10) ) );
+    }
+    // every reader receives samples.
+    for (unsigned int i = 0; i < readers.size(); ++i) {
+        while ( readers[i]->read(val) != NewData )
+            ;
+        readers[i]->disconnect();
+        BOOST_CHECK( !readers[i]->connected() );
+    }
+
+    BOOST_CHECK( athread.stop() );
+    BOOST_CHECK( !wp1.connected() );
+    for (unsigned int i = 0; i < readers.size(); ++i)
+        delete readers[i];
+}
+
+BOOST_AUTO_TEST_CASE(testPortDisconnectWhileWriting)
+{
+    OutputPort<double> wp1("Write");
+    InputPort<double>  rp1("Read");
+    PortWriter writer(wp1);
+    double val = -1;
+
+    Activity athread(ORO_SCHED_OTHER, 0, 0, &writer, "PortWriter");
+    BOOST_REQUIRE( athread.start() );
+    while ( writer.writes == 0 )
+        usleep(1000);
+
+    // the channel topology is modified from this thread while the
+    // writer thread walks it.
+    for (int i = 0; i < 1000; ++i) {
+        BOOST_REQUIRE( wp1.createConnection(rp1, i % 2 ? ConnPolicy::data() : ConnPolicy::buffer(10)) );
+        rp1.read(val);
+        if (i % 3)
+            rp1.disconnect();
+        else
+            wp1.disconnect();
+        BOOST_CHECK( !rp1.connected() );
+    }
+
+    BOOST_CHECK( athread.stop() );
+    BOOST_CHECK( writer.writes > 0 );
+    BOOST_CHECK( !wp1.connected() );
+    BOOST_CHECK_EQUAL( rp1.read(val), NoData );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
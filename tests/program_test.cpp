@@ -383,6 +383,37 @@ BOOST_AUTO_TEST_CASE(testProgramLoops)
     this->finishProgram( tc, "x");
 }
 
+BOOST_AUTO_TEST_CASE(testProgramConstantConditions)
+{
+    // see if folded constant conditions and threaded jumps work
+    string prog = string("program x { \n")
+        + "if true then \n"
+        + "    do test.good() \n"
+        + "else \n"
+        + "    do test.fail() \n"
+        + "if false then \n"
+        + "    do test.fail() \n"
+        + "while false { \n"
+        + "    do test.fail() \n"
+        + "} \n" // 10
+        + "do test.resetI()\n"
+        + "while true { \n"
+        + "    if test.increase() == 1000 then break \n"
+        + "} \n"
+        + "if test.i != 1000 then \n"
+        + "    do test.fail() \n"
+        + "do test.resetI()\n"
+        + "while true { \n"
+        + "    if test.increase() == 10 then break \n"
+        + "    yield \n"
+        + "} \n"
+        + "if test.i != 10 then \n" // 20
+        + "    do test.fail() \n"
+        + "}";
+    this->doProgram( prog, tc );
+    this->finishProgram( tc, "x");
+}
+
 BOOST_AUTO_TEST_CASE(testProgramAnd)
 {
     // see if checking a remote condition works
@@ -19,7 +19,9 @@
 
 #include "unit.hpp"
 #include "marsh/PropertyLoader.hpp"
+#include "marsh/CPFBlob.hpp"
 #include "TaskContext.hpp"
+#include <fstream>
 
 struct LoaderTest {
     LoaderTest() : tc("tc"), pl(&tc),
@@ -181,4 +183,42 @@ BOOST_AUTO_TEST_CASE( testPropStoring )
     BOOST_CHECK_EQUAL(bagvector.value()[2], 4.123);
 }
 
+/**
+ * Test configuring a vector from a base64 encoded array and
+ * rolling back the properties touched by a failed configure.
+ */
+BOOST_AUTO_TEST_CASE( testPropArrayBlob )
+{
+    std::string filename = "property_blob.tst";
+    vector<double> values(1000);
+    for (unsigned int i = 0; i != values.size(); ++i)
+        values[i] = i * 0.5;
+    {
+        std::ofstream file( filename.c_str() );
+        file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<properties>\n"
+             << "  <simple name=\"pdouble\" type=\"double\"><value>2.5</value></simple>\n"
+             << "  <simple name=\"pdoubles\" type=\"array\" encoding=\"base64\"><value>"
+             << encodeDoubles( values ) << "</value></simple>\n</properties>\n";
+    }
+    tc.addProperty(pdouble);
+    tc.addProperty(pdoubles);
+    BOOST_REQUIRE( pl.configure(filename, true) );
+    BOOST_CHECK_EQUAL( pdouble.get(), 2.5 );
+    BOOST_REQUIRE_EQUAL( pdoubles.get().size(), values.size() );
+    BOOST_CHECK( pdoubles.get() == values );
+
+    // pstring can not be configured from a double:
+    {
+        std::ofstream file( filename.c_str() );
+        file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<properties>\n"
+             << "  <simple name=\"pdouble\" type=\"double\"><value>7</value></simple>\n"
+             << "  <simple name=\"pstring\" type=\"double\"><value>7</value></simple>\n</properties>\n";
+    }
+    tc.addProperty(pstring);
+    BOOST_CHECK( !pl.configure(filename, false) );
+    BOOST_CHECK_EQUAL( pdouble.get(), 2.5 );
+    BOOST_CHECK_EQUAL( pstring.get(), "Hello World" );
+    BOOST_CHECK( pdoubles.get() == values );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
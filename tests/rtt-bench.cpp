@@ -0,0 +1,497 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  rtt-bench.cpp
+
+                        rtt-bench.cpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/**
+ * @file rtt-bench.cpp
+ * Micro- and macro-benchmarks of the RTT data flow, operations and
+ * activities. Each case is run once to warm up and then timed a number
+ * of repetitions; the median and minimum time per operation are reported
+ * as JSON or CSV, such that results of different builds can be diffed.
+ *
+ * Usage: rtt-bench [--format=json|csv] [--output=file] [--filter=text]
+ *                  [--repetitions=N] [--quick]
+ */
+
+#include <os/main.h>
+#include <os/TimeService.hpp>
+#include <os/MainThread.hpp>
+#include <os/Atomic.hpp>
+#include <Logger.hpp>
+#include <TaskContext.hpp>
+#include <InputPort.hpp>
+#include <OutputPort.hpp>
+#include <Operation.hpp>
+#include <OperationCaller.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+using namespace RTT;
+using namespace std;
+
+namespace {
+
+    // transport ids, see CorbaLib.hpp and MQLib.hpp
+    const int CORBA_PROTOCOL_ID = 1;
+    const int MQUEUE_PROTOCOL_ID = 2;
+
+    typedef std::vector<double> Sample;
+
+    struct Options {
+        Options() : format("json"), repetitions(5), quick(false) {}
+        string format, output, filter;
+        unsigned int repetitions;
+        bool quick;
+    };
+
+    /**
+     * One measured case.
+     */
+    struct Result {
+        Result(string s, string n, string v, unsigned int sz = 0, unsigned int p = 0)
+            : suite(s), name(n), variant(v), size(sz), peers(p), iterations(0), ns_per_op(0), ns_per_op_min(0) {}
+        string suite, name, variant;
+        /** Sample size in bytes, or zero. */
+        unsigned int size;
+        /** Number of connected peers for fan-out and fan-in, or zero. */
+        unsigned int peers;
+        unsigned int iterations;
+        /** Median over the repetitions. */
+        double ns_per_op;
+        double ns_per_op_min;
+    };
+
+    Options options;
+    vector<Result> results;
+
+    /**
+     * A benchmark case: run() executes \a n operations.
+     */
+    struct Benchmark {
+        virtual ~Benchmark() {}
+        virtual bool run(unsigned int n) = 0;
+    };
+
+    bool selected(const Result& r)
+    {
+        return options.filter.empty() || (r.suite + "/" + r.name + "/" + r.variant).find(options.filter) != string::npos;
+    }
+
+    /**
+     * Number of iterations for samples of \a size bytes, such that
+     * large samples do not take forever.
+     */
+    unsigned int iterationsFor(unsigned int size, unsigned int max_iterations = 100000)
+    {
+        unsigned int n = size ? (256 * 1024 * 1024) / size : max_iterations;
+        return std::max(10u, std::min(max_iterations, n));
+    }
+
+    void measure(Result r, Benchmark& b, unsigned int iterations)
+    {
+        if ( options.quick )
+            iterations = std::max(1u, iterations / 100);
+        // warm up caches, allocators and threads:
+        if ( !b.run( std::max(1u, iterations / 10) ) ) {
+            log(Warning) << "Skipping " << r.suite << "/" << r.name << "/" << r.variant << ": it failed to run." << endlog();
+            return;
+        }
+        vector<double> samples;
+        for (unsigned int i = 0; i != options.repetitions; ++i) {
+            os::TimeService::nsecs start = os::TimeService::Instance()->getNSecs();
+            if ( !b.run( iterations ) ) {
+                log(Warning) << "Skipping " << r.suite << "/" << r.name << "/" << r.variant << ": it failed to run." << endlog();
+                return;
+            }
+            samples.push_back( double( os::TimeService::Instance()->getNSecs() - start ) / iterations );
+        }
+        sort( samples.begin(), samples.end() );
+        r.iterations = iterations;
+        r.ns_per_op = samples[ samples.size() / 2 ];
+        r.ns_per_op_min = samples.front();
+        results.push_back( r );
+        cerr << r.suite << "/" << r.name << "/" << r.variant << " size=" << r.size << " peers=" << r.peers
+             << ": " << r.ns_per_op << " ns/op" << endl;
+    }
+
+    const char* typeName(int type)
+    {
+        switch (type) {
+        case ConnPolicy::DATA: return "DATA";
+        case ConnPolicy::BUFFER: return "BUFFER";
+        default: return "CIRCULAR_BUFFER";
+        }
+    }
+
+    const char* lockName(int lock)
+    {
+        switch (lock) {
+        case ConnPolicy::UNSYNC: return "UNSYNC";
+        case ConnPolicy::LOCKED: return "LOCKED";
+        default: return "LOCK_FREE";
+        }
+    }
+
+    /**
+     * Writes on each output and reads all inputs until they are empty,
+     * all in the calling thread.
+     */
+    struct PortBenchmark : public Benchmark {
+        vector< OutputPort<Sample>* > outs;
+        vector< InputPort<Sample>* > ins;
+        Sample sample, result;
+
+        PortBenchmark(unsigned int size, unsigned int nouts, unsigned int nins)
+            : sample( std::max(1u, size / unsigned(sizeof(double))), 1.0 ), result( sample )
+        {
+            for (unsigned int i = 0; i != nouts; ++i) {
+                outs.push_back( new OutputPort<Sample>("out") );
+                outs.back()->setDataSample( sample );
+            }
+            for (unsigned int i = 0; i != nins; ++i)
+                ins.push_back( new InputPort<Sample>("in") );
+        }
+
+        ~PortBenchmark()
+        {
+            for (unsigned int i = 0; i != outs.size(); ++i) {
+                outs[i]->disconnect();
+                delete outs[i];
+            }
+            for (unsigned int i = 0; i != ins.size(); ++i)
+                delete ins[i];
+        }
+
+        bool connect(ConnPolicy policy)
+        {
+            for (unsigned int o = 0; o != outs.size(); ++o)
+                for (unsigned int i = 0; i != ins.size(); ++i)
+                    if ( !outs[o]->connectTo( ins[i], policy ) )
+                        return false;
+            return true;
+        }
+
+        bool run(unsigned int n)
+        {
+            for (unsigned int k = 0; k != n; ++k) {
+                for (unsigned int o = 0; o != outs.size(); ++o)
+                    outs[o]->write( sample );
+                for (unsigned int i = 0; i != ins.size(); ++i)
+                    while ( ins[i]->read( result, false ) == NewData )
+                        ;
+            }
+            return true;
+        }
+    };
+
+    void benchDataFlow()
+    {
+        const int types[] = { ConnPolicy::DATA, ConnPolicy::BUFFER, ConnPolicy::CIRCULAR_BUFFER };
+        const int locks[] = { ConnPolicy::LOCK_FREE, ConnPolicy::LOCKED, ConnPolicy::UNSYNC };
+        const unsigned int sizes[] = { 8, 64, 512, 4096, 65536, 1024 * 1024, 8 * 1024 * 1024 };
+
+        for (unsigned int t = 0; t != 3; ++t)
+            for (unsigned int l = 0; l != 3; ++l)
+                for (unsigned int s = 0; s != sizeof(sizes) / sizeof(sizes[0]); ++s) {
+                    Result r("dataflow", typeName(types[t]), lockName(locks[l]), sizes[s], 1);
+                    if ( !selected(r) )
+                        continue;
+                    PortBenchmark b( sizes[s], 1, 1 );
+                    ConnPolicy policy( types[t], locks[l] );
+                    policy.size = 4;
+                    if ( !b.connect( policy ) ) {
+                        log(Warning) << "Could not connect " << r.name << "/" << r.variant << endlog();
+                        continue;
+                    }
+                    measure( r, b, iterationsFor( sizes[s] ) );
+                }
+    }
+
+    void benchFanOutIn()
+    {
+        const int types[] = { ConnPolicy::DATA, ConnPolicy::BUFFER };
+        const unsigned int sizes[] = { 8, 4096, 65536 };
+        const unsigned int peers[] = { 1, 4, 16 };
+
+        for (unsigned int fanin = 0; fanin != 2; ++fanin)
+            for (unsigned int t = 0; t != 2; ++t)
+                for (unsigned int s = 0; s != 3; ++s)
+                    for (unsigned int p = 0; p != 3; ++p) {
+                        Result r(fanin ? "fan-in" : "fan-out", typeName(types[t]), "LOCK_FREE", sizes[s], peers[p]);
+                        if ( !selected(r) )
+                            continue;
+                        PortBenchmark b( sizes[s], fanin ? peers[p] : 1, fanin ? 1 : peers[p] );
+                        ConnPolicy policy( types[t], ConnPolicy::LOCK_FREE );
+                        policy.size = 4;
+                        if ( !b.connect( policy ) ) {
+                            log(Warning) << "Could not connect " << r.suite << "/" << r.name << endlog();
+                            continue;
+                        }
+                        measure( r, b, iterationsFor( sizes[s] * peers[p], 20000 ) );
+                    }
+    }
+
+    /**
+     * Writes a sample over a transport and waits until it is read.
+     */
+    struct TransportBenchmark : public PortBenchmark {
+        TransportBenchmark(unsigned int size) : PortBenchmark(size, 1, 1) {}
+
+        bool run(unsigned int n)
+        {
+            for (unsigned int k = 0; k != n; ++k) {
+                outs[0]->write( sample );
+                os::TimeService::nsecs start = os::TimeService::Instance()->getNSecs();
+                while ( ins[0]->read( result, false ) != NewData ) {
+                    if ( os::TimeService::Instance()->getNSecs() - start > 1000000000LL )
+                        return false;
+                    os::MainThread::Instance()->yield();
+                }
+            }
+            return true;
+        }
+    };
+
+    void benchTransports()
+    {
+        const int transports[] = { MQUEUE_PROTOCOL_ID, CORBA_PROTOCOL_ID };
+        const char* names[] = { "mqueue", "corba" };
+        const unsigned int sizes[] = { 8, 512, 4096, 65536 };
+
+        for (unsigned int t = 0; t != 2; ++t)
+            for (unsigned int s = 0; s != 4; ++s) {
+                Result r("transport", names[t], "DATA", sizes[s], 1);
+                if ( !selected(r) )
+                    continue;
+                TransportBenchmark b( sizes[s] );
+                ConnPolicy policy = ConnPolicy::data();
+                policy.transport = transports[t];
+                if ( !b.connect( policy ) ) {
+                    log(Warning) << "Transport " << names[t] << " is not available for size " << sizes[s] << ": skipped." << endlog();
+                    continue;
+                }
+                measure( r, b, iterationsFor( sizes[s], 2000 ) );
+            }
+    }
+
+    class OperationServer : public TaskContext
+    {
+    public:
+        OperationServer() : TaskContext("bench_server")
+        {
+            this->addOperation("clientthread", &OperationServer::add, this, ClientThread);
+            this->addOperation("ownthread", &OperationServer::add, this, OwnThread);
+        }
+        double add(double d) { return d + 1.0; }
+    };
+
+    struct CallBenchmark : public Benchmark {
+        OperationCaller<double(double)>& op;
+        CallBenchmark(OperationCaller<double(double)>& o) : op(o) {}
+        bool run(unsigned int n)
+        {
+            double d = 0;
+            for (unsigned int k = 0; k != n; ++k)
+                d = op( d );
+            return d == n;
+        }
+    };
+
+    struct SendCollectBenchmark : public Benchmark {
+        OperationCaller<double(double)>& op;
+        SendCollectBenchmark(OperationCaller<double(double)>& o) : op(o) {}
+        bool run(unsigned int n)
+        {
+            for (unsigned int k = 0; k != n; ++k) {
+                SendHandle<double(double)> h = op.send( 1.0 );
+                if ( h.collect() != SendSuccess )
+                    return false;
+            }
+            return true;
+        }
+    };
+
+    /**
+     * Queues batches of messages in the server's ExecutionEngine before
+     * collecting them, to measure its message throughput.
+     */
+    struct MessageBenchmark : public Benchmark {
+        OperationCaller<double(double)>& op;
+        vector< SendHandle<double(double)> > handles;
+        MessageBenchmark(OperationCaller<double(double)>& o) : op(o), handles(16) {}
+        bool run(unsigned int n)
+        {
+            for (unsigned int k = 0; k < n; k += handles.size()) {
+                for (unsigned int h = 0; h != handles.size(); ++h)
+                    handles[h] = op.send( 1.0 );
+                for (unsigned int h = 0; h != handles.size(); ++h)
+                    if ( handles[h].collect() != SendSuccess )
+                        return false;
+            }
+            return true;
+        }
+    };
+
+    void benchOperations()
+    {
+        OperationServer server;
+        TaskContext client("bench_client");
+        server.start();
+        client.start();
+        const char* threads[] = { "clientthread", "ownthread" };
+        for (unsigned int t = 0; t != 2; ++t) {
+            OperationCaller<double(double)> op( server.getOperation( threads[t] ), client.engine() );
+            Result call("operation", "call", threads[t]);
+            if ( selected(call) ) {
+                CallBenchmark b( op );
+                measure( call, b, t ? 10000 : 1000000 );
+            }
+            Result send("operation", "send-collect", threads[t]);
+            if ( selected(send) ) {
+                SendCollectBenchmark b( op );
+                measure( send, b, t ? 10000 : 1000000 );
+            }
+        }
+        Result messages("engine", "messages", "ownthread");
+        if ( selected(messages) ) {
+            OperationCaller<double(double)> op( server.getOperation("ownthread"), client.engine() );
+            MessageBenchmark b( op );
+            measure( messages, b, 16000 );
+        }
+        client.stop();
+        server.stop();
+    }
+
+    class TriggeredTask : public TaskContext
+    {
+    public:
+        os::AtomicInt cycles;
+        TriggeredTask() : TaskContext("bench_triggered"), cycles(0) {}
+        void updateHook() { cycles.inc(); }
+    };
+
+    /**
+     * Triggers a non periodic activity and waits until it executed.
+     */
+    struct TriggerBenchmark : public Benchmark {
+        TriggeredTask& task;
+        TriggerBenchmark(TriggeredTask& t) : task(t) {}
+        bool run(unsigned int n)
+        {
+            for (unsigned int k = 0; k != n; ++k) {
+                int before = task.cycles.read();
+                if ( !task.trigger() )
+                    return false;
+                while ( task.cycles.read() == before )
+                    os::MainThread::Instance()->yield();
+            }
+            return true;
+        }
+    };
+
+    void benchActivities()
+    {
+        Result r("activity", "trigger", "non-periodic");
+        if ( !selected(r) )
+            return;
+        TriggeredTask task;
+        task.start();
+        TriggerBenchmark b( task );
+        measure( r, b, 10000 );
+        task.stop();
+    }
+
+    void writeJson(ostream& os)
+    {
+        os << "{\n  \"rtt_version\": \"" << RTT_VERSION_MAJOR << "." << RTT_VERSION_MINOR << "." << RTT_VERSION_PATCH << "\",\n"
+           << "  \"target\": \"" << OROCOS_TARGET_NAME << "\",\n"
+           << "  \"repetitions\": " << options.repetitions << ",\n"
+           << "  \"results\": [";
+        for (unsigned int i = 0; i != results.size(); ++i) {
+            const Result& r = results[i];
+            os << (i ? ",\n" : "\n")
+               << "    { \"suite\": \"" << r.suite << "\", \"name\": \"" << r.name << "\", \"variant\": \"" << r.variant
+               << "\", \"size\": " << r.size << ", \"peers\": " << r.peers << ", \"iterations\": " << r.iterations
+               << ", \"ns_per_op\": " << r.ns_per_op << ", \"ns_per_op_min\": " << r.ns_per_op_min << " }";
+        }
+        os << "\n  ]\n}\n";
+    }
+
+    void writeCsv(ostream& os)
+    {
+        os << "suite,name,variant,size,peers,iterations,ns_per_op,ns_per_op_min\n";
+        for (unsigned int i = 0; i != results.size(); ++i) {
+            const Result& r = results[i];
+            os << r.suite << "," << r.name << "," << r.variant << "," << r.size << "," << r.peers << ","
+               << r.iterations << "," << r.ns_per_op << "," << r.ns_per_op_min << "\n";
+        }
+    }
+
+    bool parseOptions(int argc, char** argv)
+    {
+        for (int i = 1; i < argc; ++i) {
+            string arg = argv[i];
+            if ( arg.find("--format=") == 0 )
+                options.format = arg.substr(9);
+            else if ( arg.find("--output=") == 0 )
+                options.output = arg.substr(9);
+            else if ( arg.find("--filter=") == 0 )
+                options.filter = arg.substr(9);
+            else if ( arg.find("--repetitions=") == 0 )
+                istringstream( arg.substr(14) ) >> options.repetitions;
+            else if ( arg == "--quick" )
+                options.quick = true;
+            else
+                return false;
+        }
+        return (options.format == "json" || options.format == "csv") && options.repetitions > 0;
+    }
+}
+
+int ORO_main(int argc, char** argv)
+{
+    if ( !parseOptions(argc, argv) ) {
+        cerr << "Usage: " << argv[0] << " [--format=json|csv] [--output=file] [--filter=text] [--repetitions=N] [--quick]" << endl;
+        return 1;
+    }
+
+    benchDataFlow();
+    benchFanOutIn();
+    benchOperations();
+    benchActivities();
+    benchTransports();
+
+    ofstream file;
+    if ( !options.output.empty() ) {
+        file.open( options.output.c_str() );
+        if ( !file ) {
+            cerr << "Could not open " << options.output << " for writing." << endl;
+            return 1;
+        }
+    }
+    ostream& os = options.output.empty() ? cout : file;
+    if ( options.format == "json" )
+        writeJson( os );
+    else
+        writeCsv( os );
+    return 0;
+}
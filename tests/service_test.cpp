@@ -305,6 +305,73 @@ BOOST_AUTO_TEST_CASE(testOwnThreadOperationCallerSend)
 
 }
 
+/**
+ * Gives access to the object which executes a send().
+ */
+template<class T>
+struct InspectSendHandle : public SendHandle<T>
+{
+    InspectSendHandle(const SendHandle<T>& h) : SendHandle<T>(h) {}
+    const void* invocation() const { return this->cimpl; }
+};
+
+BOOST_AUTO_TEST_CASE(testOwnThreadOperationCallerSendPool)
+{
+    OperationCaller<double(int)> m1("o1", tc->provides("methods"), caller->engine() );
+    BOOST_REQUIRE( tc->isRunning() );
+    BOOST_CHECK( m1.setSendPoolDepth(2) );
+
+    const void* first = 0;
+    const void* second = 0;
+    {
+        SendHandle<double(int)> h1 = m1.send(1);
+        SendHandle<double(int)> h2 = m1.send(0);
+        BOOST_CHECK_EQUAL( SendSuccess, h1.collect() );
+        BOOST_CHECK_EQUAL( SendSuccess, h2.collect() );
+        first = InspectSendHandle<double(int)>(h1).invocation();
+        second = InspectSendHandle<double(int)>(h2).invocation();
+        BOOST_CHECK( first != 0 );
+        BOOST_CHECK( second != 0 );
+        BOOST_CHECK( first != second );
+    }
+    // dropped handles give their invocation back to the pool once the
+    // caller's engine has disposed it.
+    usleep(100000);
+    for (int i = 0; i != 10; ++i) {
+        SendHandle<double(int)> h = m1.send( i % 2 );
+        const void* inv = InspectSendHandle<double(int)>(h).invocation();
+        BOOST_CHECK( inv == first || inv == second );
+        double retn = 0;
+        BOOST_CHECK_EQUAL( SendSuccess, h.collect(retn) );
+        BOOST_CHECK_EQUAL( retn, i % 2 ? -2.0 : 2.0 );
+        h = SendHandle<double(int)>();
+        usleep(10000);
+    }
+
+    // more handles in use than the depth of the pool.
+    SendHandle<double(int)> h1 = m1.send(1);
+    SendHandle<double(int)> h2 = m1.send(0);
+    SendHandle<double(int)> h3 = m1.send(1);
+    BOOST_CHECK( InspectSendHandle<double(int)>(h3).invocation() != first );
+    BOOST_CHECK( InspectSendHandle<double(int)>(h3).invocation() != second );
+    double retn = 0;
+    BOOST_CHECK_EQUAL( SendSuccess, h1.collect(retn) );
+    BOOST_CHECK_EQUAL( retn, -2.0 );
+    BOOST_CHECK_EQUAL( SendSuccess, h2.collect(retn) );
+    BOOST_CHECK_EQUAL( retn, 2.0 );
+    BOOST_CHECK_EQUAL( SendSuccess, h3.collect(retn) );
+    BOOST_CHECK_EQUAL( retn, -2.0 );
+
+    BOOST_CHECK( m1.setSendPoolDepth(0) );
+    h1 = m1.send(1);
+    BOOST_CHECK_EQUAL( SendSuccess, h1.collect(retn) );
+    BOOST_CHECK_EQUAL( retn, -2.0 );
+    BOOST_CHECK_EQUAL( -2.0, m1(1) );
+
+    OperationCaller<double(int)> notready("o1");
+    BOOST_CHECK( !notready.setSendPoolDepth(2) );
+}
+
 BOOST_AUTO_TEST_CASE(testOwnThreadOperationCallerSend_ChangePolicy)
 {
     // Tests changing the policy later on
@@ -0,0 +1,270 @@
+/***************************************************************************
+  tag: Orocos Developers  Sun Oct 18 2026  shm_test.cpp
+
+                        shm_test.cpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 Orocos Developers
+    email                : orocos-dev@lists.mech.kuleuven.be
+
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "unit.hpp"
+
+#include <iostream>
+
+#include <Service.hpp>
+#include <transports/shm/ShmLib.hpp>
+#include <transports/shm/ShmRing.hpp>
+#include <os/fosi.h>
+#include <sys/mman.h>
+
+#include <InputPort.hpp>
+#include <OutputPort.hpp>
+#include <TaskContext.hpp>
+#include <string>
+
+using namespace std;
+using namespace RTT;
+using namespace RTT::detail;
+
+class ShmTest
+{
+public:
+    ShmTest()
+    {
+        mr2 = new InputPort<double>("mr");
+        mw1 = new OutputPort<double>("mw");
+
+        tc =  new TaskContext( "root" );
+        tc->ports()->addPort( *mw1 );
+
+        t2 = new TaskContext("other");
+        t2->ports()->addEventPort( *mr2, boost::bind(&ShmTest::new_data_listener, this, _1) );
+
+        tc->start();
+        t2->start();
+    }
+
+    ~ShmTest()
+    {
+        delete tc;
+        delete t2;
+
+        delete mr2;
+        delete mw1;
+    }
+
+    TaskContext* tc;
+    TaskContext* t2;
+
+    PortInterface* signalled_port;
+    void new_data_listener(PortInterface* port)
+    {
+        signalled_port = port;
+    }
+
+    InputPort<double>*  mr2;
+    OutputPort<double>* mw1;
+
+    ConnPolicy policy;
+
+    void testPortDataConnection();
+    void testPortBufferConnection();
+    void testPortDisconnected();
+};
+
+class ShmFixture : public ShmTest
+{
+public:
+    ShmFixture() {
+        policy.type = ConnPolicy::DATA;
+        policy.init = false;
+        policy.lock_policy = ConnPolicy::LOCK_FREE;
+        policy.size = 0;
+        policy.pull = true;
+        policy.transport = ORO_SHM_PROTOCOL_ID;
+    }
+};
+
+#define ASSERT_PORT_SIGNALLING(code, read_port) \
+    signalled_port = 0; \
+    code; \
+    rtos_disable_rt_warning(); \
+    usleep(100000); \
+    rtos_enable_rt_warning(); \
+    BOOST_CHECK( read_port == signalled_port );
+
+void ShmTest::testPortDataConnection()
+{
+    rtos_enable_rt_warning();
+    BOOST_CHECK( mw1->connected() );
+    BOOST_CHECK( mr2->connected() );
+
+    double value = 0;
+
+    BOOST_CHECK( NoData == mr2->read(value) );
+
+    ASSERT_PORT_SIGNALLING(mw1->write(1.0), mr2)
+    BOOST_CHECK( mr2->read(value) );
+    BOOST_CHECK_EQUAL( 1.0, value );
+    ASSERT_PORT_SIGNALLING(mw1->write(2.0), mr2);
+    BOOST_CHECK( mr2->read(value) );
+    BOOST_CHECK_EQUAL( 2.0, value );
+    BOOST_CHECK( OldData == mr2->read(value) );
+
+    rtos_disable_rt_warning();
+}
+
+void ShmTest::testPortBufferConnection()
+{
+    rtos_enable_rt_warning();
+    BOOST_CHECK( mw1->connected() );
+    BOOST_CHECK( mr2->connected() );
+
+    double value = 0;
+
+    BOOST_CHECK( NoData == mr2->read(value) );
+
+    ASSERT_PORT_SIGNALLING(mw1->write(1.0), mr2);
+    ASSERT_PORT_SIGNALLING(mw1->write(2.0), mr2);
+    ASSERT_PORT_SIGNALLING(mw1->write(3.0), mr2);
+    ASSERT_PORT_SIGNALLING(mw1->write(4.0), 0);  // because size == 3
+    BOOST_CHECK( mr2->read(value) );
+    BOOST_CHECK_EQUAL( 1.0, value );
+    BOOST_CHECK( mr2->read(value) );
+    BOOST_CHECK_EQUAL( 2.0, value );
+    BOOST_CHECK( mr2->read(value) );
+    BOOST_CHECK_EQUAL( 3.0, value );
+    BOOST_CHECK( OldData == mr2->read(value) );
+
+    rtos_disable_rt_warning();
+}
+
+void ShmTest::testPortDisconnected()
+{
+    BOOST_CHECK( !mw1->connected() );
+    BOOST_CHECK( !mr2->connected() );
+}
+
+BOOST_FIXTURE_TEST_SUITE(  ShmTestSuite,  ShmFixture )
+
+/**
+ * Tests the ring on its own: ordering, the full condition and
+ * the wakeup of a waiting reader.
+ */
+BOOST_AUTO_TEST_CASE( testRing )
+{
+    shm::ShmRing writer, reader;
+    BOOST_REQUIRE( writer.open("/shm_test_ring", 3, sizeof(int)) );
+    BOOST_REQUIRE( reader.open("/shm_test_ring", 0, 0) );
+    writer.unlink();
+    BOOST_CHECK_EQUAL( reader.getCapacity(), 4u );
+    BOOST_CHECK( reader.getSlotSize() >= sizeof(int) );
+    BOOST_CHECK( reader.empty() );
+    BOOST_CHECK( !reader.waitData(1000000) );
+
+    unsigned int pos, length;
+    for (int i = 0; i != 4; ++i) {
+        char* slot = writer.beginWrite(pos);
+        BOOST_REQUIRE( slot );
+        memcpy(slot, &i, sizeof(int));
+        writer.commitWrite(pos, sizeof(int));
+    }
+    BOOST_CHECK( writer.beginWrite(pos) == 0 );
+
+    BOOST_CHECK( reader.waitData(-1) );
+    for (int i = 0; i != 4; ++i) {
+        const char* data = reader.beginRead(length);
+        BOOST_REQUIRE( data );
+        BOOST_CHECK_EQUAL( length, sizeof(int) );
+        BOOST_CHECK_EQUAL( *(const int*)data, i );
+        reader.commitRead();
+    }
+    BOOST_CHECK( reader.beginRead(length) == 0 );
+    BOOST_CHECK( writer.beginWrite(pos) != 0 );
+    writer.commitWrite(pos, 0);
+    BOOST_CHECK( !reader.empty() );
+}
+
+/**
+ * This unit test checks a manual setup of shm data flow,
+ * without any use of CORBA to mediate the connection.
+ */
+BOOST_AUTO_TEST_CASE( testPortConnections )
+{
+    policy.type = ConnPolicy::DATA;
+    policy.pull = true;
+    policy.name_id = "/shmdata1";
+    BOOST_REQUIRE( mw1->createConnection(*mr2, policy) );
+    BOOST_CHECK( policy.name_id == "/shmdata1" );
+    testPortDataConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = false;
+    policy.size = 3;
+    policy.name_id = "";
+    BOOST_REQUIRE( mw1->createConnection(*mr2, policy) );
+    testPortBufferConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+}
+
+BOOST_AUTO_TEST_CASE( testPortStreams )
+{
+    policy.type = ConnPolicy::DATA;
+    policy.pull = false;
+    policy.name_id = "/shmdata1";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    testPortDataConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = true;
+    policy.size = 3;
+    policy.name_id = "";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    testPortBufferConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+}
+
+BOOST_AUTO_TEST_CASE( testPortStreamsTimeout )
+{
+    // Test creating an input stream without an output stream available.
+    policy.type = ConnPolicy::DATA;
+    policy.pull = false;
+    policy.name_id = "/shmdata2";
+    BOOST_REQUIRE( mr2->createStream( policy ) == false );
+    BOOST_CHECK( mr2->connected() == false );
+    mr2->disconnect();
+    shm_unlink("/shmdata2");
+}
+
+BOOST_AUTO_TEST_CASE( testPortStreamsWrongName )
+{
+    policy.type = ConnPolicy::DATA;
+    policy.pull = false;
+    policy.name_id = "shmdata1"; // name must start with '/'
+    BOOST_REQUIRE( mr2->createStream( policy ) == false );
+    BOOST_CHECK( mr2->connected() == false );
+    mr2->disconnect();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
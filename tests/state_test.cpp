@@ -766,6 +766,44 @@ BOOST_AUTO_TEST_CASE( testStateTransitions)
      this->finishState( "x", tc);
 }
 
+BOOST_AUTO_TEST_CASE( testStateConstantTransitions)
+{
+    // test processing of constant transition conditions and preconditions.
+    string prog = string("StateMachine X {\n")
+        + " initial state INIT {\n"
+        + " var int i = 0;\n" // transition counter
+        + " transitions {\n"
+        + "  if false then select FAILED\n"
+        + "  if i < 3 then {\n"
+        + "    set i = i + 1;\n"
+        + "  } select INIT\n"
+        + "  if true then select BLOCKED\n" // precondition fails
+        + "  if i == 3 then select NEXT\n"
+        + " }\n"
+        + " }\n"
+        + " state BLOCKED {\n"
+        + " precondition false\n"
+        + " entry { do test.assert(false); }\n"
+        + " }\n"
+        + " state NEXT {\n"
+        + " precondition true\n"
+        + " transitions {\n"
+        + "  if true then select FINI\n"
+        + " }\n"
+        + " }\n"
+        + " state FAILED {\n"           // failure state
+        + " entry { do test.assert(false); }\n"
+        + " }\n"
+        + " final state FINI {\n" // Success state.
+        + " }\n"
+        + " }\n"
+        + " RootMachine X x\n" // instantiate a non hierarchical SC
+        ;
+     this->doState("x", prog, tc );
+     BOOST_CHECK( sa->getStateMachine( "x" )->inState("FINI") );
+     this->finishState( "x", tc);
+}
+
 BOOST_AUTO_TEST_CASE( testStateTransitionStop )
 {
     // test processing of transition statements.
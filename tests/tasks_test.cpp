@@ -325,6 +325,40 @@ BOOST_AUTO_TEST_CASE( testThread )
   t->run(0);
 }
 
+BOOST_AUTO_TEST_CASE( testThreadStatistics )
+{
+  boost::scoped_ptr<TestPeriodic> run( new TestPeriodic() );
+  boost::scoped_ptr<ActivityInterface> t( new Activity(ORO_SCHED_OTHER, 0, 0.01, 0, "StatThread") );
+  t->run( run.get() );
+
+  BOOST_CHECK_EQUAL( t->thread()->getStatistics().cycles, 0u );
+  BOOST_CHECK( t->start() );
+  usleep(1000*300);
+  BOOST_CHECK( t->stop() );
+
+  os::ThreadStatistics stats = t->thread()->getStatistics();
+  BOOST_CHECK_GT( stats.cycles, 10u );
+  BOOST_CHECK_EQUAL( stats.wakeups, stats.cycles - 1 );
+  unsigned int histogram = 0;
+  for (unsigned int i = 0; i != os::ThreadStatistics::JitterBuckets; ++i)
+      histogram += stats.jitter_histogram[i];
+  BOOST_CHECK_EQUAL( histogram, stats.wakeups );
+  BOOST_CHECK_LE( stats.step_min, stats.step_mean );
+  BOOST_CHECK_LE( stats.step_mean, stats.step_max );
+  BOOST_CHECK_LE( stats.latency_min, stats.latency_mean );
+  BOOST_CHECK_LE( stats.latency_mean, stats.latency_max );
+  BOOST_CHECK_LE( stats.overruns, stats.cycles );
+
+  // the thread clears its statistics when it runs again.
+  t->thread()->resetStatistics();
+  BOOST_CHECK_EQUAL( t->thread()->getStatistics().cycles, stats.cycles );
+  BOOST_CHECK( t->start() );
+  usleep(1000*50);
+  BOOST_CHECK( t->stop() );
+  BOOST_CHECK_LT( t->thread()->getStatistics().cycles, stats.cycles );
+  t->run(0);
+}
+
 #if defined( OROCOS_TARGET_GNULINUX )
 // run on just the target CPU
 void testAffinity2(boost::scoped_ptr<TestPeriodic>& run,
@@ -25,6 +25,8 @@
 #include <extras/SequentialActivity.hpp>
 #include <extras/SimulationActivity.hpp>
 #include <extras/SimulationThread.hpp>
+#include <Activity.hpp>
+#include <os/Semaphore.hpp>
 
 #include <boost/function_types/function_type.hpp>
 #include <OperationCaller.hpp>
@@ -35,6 +37,30 @@ using namespace RTT::detail;
 
 struct A {};
 
+/**
+ * Counts how many times it was executed.
+ */
+struct CountingMessage : public DisposableInterface
+{
+    int volatile count;
+    CountingMessage() : count(0) {}
+    void executeAndDispose() { ++count; }
+    void dispose() {}
+    bool isError() const { return false; }
+};
+
+/**
+ * Blocks the ExecutionEngine until released.
+ */
+struct BlockingMessage : public DisposableInterface
+{
+    os::Semaphore started, release;
+    BlockingMessage() : started(0), release(0) {}
+    void executeAndDispose() { started.signal(); release.wait(); }
+    void dispose() {}
+    bool isError() const { return false; }
+};
+
 
 // Test TaskContext states.
 class StatesTC
@@ -637,5 +663,50 @@ BOOST_AUTO_TEST_CASE( testExecutionEngine)
     tsim->run(0);
 }
 
+BOOST_AUTO_TEST_CASE( testMessageQueue )
+{
+    ExecutionEngine ee(0);
+    Activity act(&ee);
+    BOOST_CHECK_EQUAL( ee.getMessageQueueCapacity(), 100u );
+    BOOST_CHECK_EQUAL( ee.getMessageOverflowCapacity(), 0u );
+    BOOST_CHECK( ee.setMessageQueueCapacity(4, 4) );
+    BOOST_CHECK_EQUAL( ee.getMessageQueueCapacity(), 4u );
+    BOOST_CHECK_EQUAL( ee.getMessageOverflowCapacity(), 4u );
+    BOOST_CHECK( ee.setFunctionQueueCapacity(10) );
+
+    BOOST_CHECK( act.start() );
+    BOOST_CHECK( !ee.setMessageQueueCapacity(10) );
+
+    // keep the engine busy while the messages arrive.
+    BlockingMessage blocker;
+    BOOST_CHECK( ee.process(&blocker) );
+    blocker.started.wait();
+
+    // 4 in the queue, 4 in the overflow queue, the last one is dropped.
+    CountingMessage msgs[9];
+    for (int i = 0; i != 9; ++i)
+        BOOST_CHECK_EQUAL( ee.process(&msgs[i]), i != 8 );
+    BOOST_CHECK_EQUAL( ee.getDroppedMessages(), 1u );
+    // only the first message triggered the activity.
+    BOOST_CHECK_EQUAL( ee.getCoalescedTriggers(), 7u );
+
+    blocker.release.signal();
+    for (int i = 0; i != 100 && msgs[7].count == 0; ++i)
+        usleep(10000);
+    for (int i = 0; i != 9; ++i)
+        BOOST_CHECK_EQUAL( msgs[i].count, i != 8 ? 1 : 0 );
+    // the blocker and the 8 messages were executed in one batch.
+    BOOST_CHECK_EQUAL( ee.getMaxQueueDepth(), 9u );
+
+    // the next message triggers the activity again.
+    CountingMessage last;
+    BOOST_CHECK( ee.process(&last) );
+    for (int i = 0; i != 100 && last.count == 0; ++i)
+        usleep(10000);
+    BOOST_CHECK_EQUAL( last.count, 1 );
+    BOOST_CHECK_EQUAL( ee.getCoalescedTriggers(), 7u );
+    BOOST_CHECK( act.stop() );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
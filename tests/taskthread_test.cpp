@@ -25,8 +25,15 @@
 
 #include <extras/Activities.hpp>
 #include <extras/TimerThread.hpp>
+#include <extras/ThreadPool.hpp>
 #include <extras/SimulationThread.hpp>
 #include <os/MainThread.hpp>
+#include <os/MemoryArena.hpp>
+#include <os/oro_malloc.h>
+#include <TaskContext.hpp>
+#include <OperationCaller.hpp>
+#include <InputPort.hpp>
+#include <internal/GlobalEngine.hpp>
 #include <Logger.hpp>
 #include <rtt-config.h>
 
@@ -405,6 +412,268 @@ BOOST_AUTO_TEST_CASE( testSequential )
     BOOST_CHECK( mtask.start() == false );
 }
 
+/**
+ * Counts its steps and detects concurrent executions of step().
+ */
+struct PoolRunner
+    : public RunnableInterface
+{
+    oro_atomic_t inside;
+    int steps;
+    bool concurrent;
+
+    PoolRunner() : steps(0), concurrent(false) { oro_atomic_set(&inside, 0); }
+
+    bool initialize() { return true; }
+    void step() {
+        oro_atomic_inc(&inside);
+        if ( oro_atomic_read(&inside) != 1 )
+            concurrent = true;
+        ++steps;
+        for (volatile int i = 0; i != 1000; ++i) ;
+        oro_atomic_dec(&inside);
+    }
+    void finalize() {}
+};
+
+BOOST_AUTO_TEST_CASE( testPoolActivity )
+{
+    int bprio = 0, rtsched = ORO_SCHED_OTHER;
+    os::CheckPriority( rtsched, bprio );
+    ThreadPoolPtr pool( new ThreadPool(rtsched, bprio, 2) );
+    BOOST_CHECK_EQUAL( 2u, pool->getWorkerCount() );
+    BOOST_CHECK_EQUAL( rtsched, pool->getScheduler() );
+    BOOST_CHECK_EQUAL( bprio, pool->getPriority() );
+    BOOST_CHECK( pool->currentWorker() == 0 );
+
+    TestRunner r(true);
+    PoolActivity mtask(pool, &r);
+    BOOST_CHECK( mtask.isActive() == false );
+    BOOST_CHECK( mtask.isRunning() == false );
+    BOOST_CHECK( mtask.isPeriodic() == false );
+    BOOST_CHECK( mtask.getPeriod() == 0.0 );
+    BOOST_CHECK( mtask.execute() == false );
+    BOOST_CHECK( mtask.trigger() == false );
+    BOOST_CHECK( mtask.thread() == pool->getWorker(0) );
+    BOOST_CHECK( !mtask.thread()->isSelf() );
+
+    // starting executes loop() once in a worker.
+    BOOST_CHECK( mtask.start() == true );
+    BOOST_CHECK( r.init == true );
+    BOOST_CHECK( mtask.isActive() == true );
+    BOOST_CHECK( mtask.start() == false );
+    usleep(100000);
+    BOOST_CHECK( r.looped == true );
+    BOOST_CHECK( r.wasrunning );
+    BOOST_CHECK( r.wasactive );
+    BOOST_CHECK( mtask.isRunning() == false );
+
+    r.looped = false;
+    BOOST_CHECK( mtask.trigger() == true );
+    usleep(100000);
+    BOOST_CHECK( r.looped == true );
+
+    // stopping...
+    BOOST_CHECK( mtask.stop() == true );
+    BOOST_CHECK( r.fini == true );
+    BOOST_CHECK( mtask.isRunning() == false );
+    BOOST_CHECK( mtask.isActive() == false );
+    BOOST_CHECK( mtask.stop() == false );
+    BOOST_CHECK( mtask.trigger() == false );
+
+    r.reset(false);
+    BOOST_CHECK( mtask.start() == false );
+    BOOST_CHECK( r.init == true );
+    BOOST_CHECK( mtask.isActive() == false );
+
+    // the shared pools are per scheduler and priority.
+    PoolActivity stask(rtsched, bprio);
+    BOOST_CHECK( stask.getThreadPool() == ThreadPool::Instance(rtsched, bprio) );
+    BOOST_CHECK( stask.getThreadPool() != pool );
+    BOOST_CHECK( stask.getThreadPool()->getWorkerCount() >= 1 );
+}
+
+BOOST_AUTO_TEST_CASE( testPoolActivityConcurrency )
+{
+    // many activities on few workers, triggered from several threads:
+    // step() of one activity may never run concurrently.
+    int bprio = 0, rtsched = ORO_SCHED_OTHER;
+    os::CheckPriority( rtsched, bprio );
+    ThreadPoolPtr pool( new ThreadPool(rtsched, bprio, 3) );
+
+    const int nact = 20;
+    PoolRunner runners[nact];
+    std::vector<PoolActivity*> acts;
+    for (int i = 0; i != nact; ++i) {
+        acts.push_back( new PoolActivity(pool, &runners[i]) );
+        BOOST_CHECK( acts.back()->start() );
+    }
+
+    struct Triggerer : public RunnableInterface {
+        std::vector<PoolActivity*>* acts;
+        bool initialize() { return true; }
+        void step() {}
+        void loop() {
+            for (int n = 0; n != 500; ++n)
+                for (unsigned int i = 0; i != acts->size(); ++i)
+                    (*acts)[i]->trigger();
+        }
+        void finalize() {}
+    } t1, t2;
+    t1.acts = &acts;
+    t2.acts = &acts;
+    Activity a1(rtsched, bprio, 0.0, &t1);
+    Activity a2(rtsched, bprio, 0.0, &t2);
+    a1.start();
+    a2.start();
+    t1.loop();
+    a1.stop();
+    a2.stop();
+
+    for (int i = 0; i != nact; ++i) {
+        BOOST_CHECK( acts[i]->stop() );
+        delete acts[i];
+        BOOST_CHECK( !runners[i].concurrent );
+        BOOST_CHECK( runners[i].steps >= 1 );
+    }
+}
+
+struct PoolOperation
+{
+    ThreadPoolPtr pool;
+    bool inworker;
+    int op() { inworker = pool->currentWorker() != 0; return 42; }
+};
+
+BOOST_AUTO_TEST_CASE( testPoolActivityTaskContext )
+{
+    // operations of a component with a PoolActivity execute in a worker.
+    int bprio = 0, rtsched = ORO_SCHED_OTHER;
+    os::CheckPriority( rtsched, bprio );
+    PoolOperation po;
+    po.pool.reset( new ThreadPool(rtsched, bprio, 2) );
+    po.inworker = false;
+
+    TaskContext tc("pooled");
+    tc.setActivity( new PoolActivity(po.pool) );
+    tc.addOperation("op", &PoolOperation::op, &po, OwnThread);
+    BOOST_CHECK( tc.start() );
+
+    OperationCaller<int(void)> op("op", tc.provides(), internal::GlobalEngine::Instance());
+    BOOST_CHECK_EQUAL( 42, op() );
+    BOOST_CHECK( po.inworker );
+    BOOST_CHECK( tc.stop() );
+}
+
+BOOST_AUTO_TEST_CASE( testTaskContextThreadStatistics )
+{
+    TaskContext tc("stats");
+    tc.setActivity( new Activity(ORO_SCHED_OTHER, 0, 0.01) );
+    BOOST_CHECK( tc.getPort("threadStatistics") == 0 );
+    BOOST_CHECK( tc.publishThreadStatistics(true) );
+    BOOST_REQUIRE( tc.getPort("threadStatistics") );
+
+    InputPort<os::ThreadStatistics> in("in");
+    BOOST_REQUIRE( tc.getPort("threadStatistics")->connectTo( &in ) );
+    BOOST_CHECK( tc.start() );
+    usleep(1000*200);
+    BOOST_CHECK( tc.stop() );
+
+    OperationCaller<os::ThreadStatistics(void)> get("getThreadStatistics", tc.provides(), internal::GlobalEngine::Instance());
+    BOOST_CHECK_GT( get().cycles, 5u );
+    os::ThreadStatistics sample;
+    BOOST_CHECK_EQUAL( in.read(sample), NewData );
+    BOOST_CHECK_GT( sample.cycles, 0u );
+    BOOST_CHECK_LE( sample.cycles, get().cycles );
+
+    BOOST_CHECK( tc.publishThreadStatistics(false) );
+    BOOST_CHECK( tc.getPort("threadStatistics") == 0 );
+}
+
+#ifdef OS_RT_MALLOC
+/**
+ * Allocates blocks with oro_rt_malloc() in its own thread.
+ */
+struct ArenaRunner
+    : public RunnableInterface
+{
+    std::vector<void*> blocks;
+    void* arena;
+
+    ArenaRunner() : arena(0) {}
+
+    bool initialize() { return true; }
+    void step() {
+        arena = os::currentMemoryArena();
+        for (unsigned int i = 0; i != blocks.size(); ++i)
+            blocks[i] = oro_rt_malloc(100 + i);
+    }
+    void finalize() {}
+};
+
+BOOST_AUTO_TEST_CASE( testThreadMemoryArena )
+{
+    ArenaRunner r;
+    r.blocks.resize(64);
+    os::MemoryStats stats;
+    {
+        os::Thread::setMemoryArenaSize(64*1024);
+        Activity act(ORO_SCHED_OTHER, 0, 0, &r, "ArenaThread");
+        os::Thread::setMemoryArenaSize(0);
+
+        BOOST_CHECK( act.start() );
+        BOOST_CHECK( act.trigger() );
+        usleep(100000);
+        BOOST_REQUIRE( r.arena != 0 );
+        BOOST_CHECK( os::currentMemoryArena() == 0 );
+
+        BOOST_REQUIRE( act.getMemoryStats(stats) );
+        BOOST_CHECK( stats.arena );
+        BOOST_CHECK( stats.size >= 64*1024 );
+        BOOST_CHECK_EQUAL( stats.remote_frees, 0u );
+        BOOST_CHECK( stats.fragmentation() >= 0.0 && stats.fragmentation() <= 1.0 );
+
+        // frees from this thread are queued to the arena.
+        for (unsigned int i = 0; i != r.blocks.size(); ++i) {
+            BOOST_REQUIRE( r.blocks[i] != 0 );
+            oro_rt_free( r.blocks[i] );
+        }
+        BOOST_REQUIRE( act.getMemoryStats(stats) );
+        BOOST_CHECK_EQUAL( stats.remote_frees, r.blocks.size() );
+
+        // the owner allocates again, after taking the queued blocks back.
+        BOOST_CHECK( act.trigger() );
+        usleep(100000);
+        BOOST_CHECK( act.stop() );
+    }
+
+    // the blocks outlive the thread, after which its arena is reused.
+    for (unsigned int i = 0; i != r.blocks.size(); ++i)
+        oro_rt_free( r.blocks[i] );
+    void* mine = os::attachMemoryArena(16*1024);
+    BOOST_REQUIRE( mine != 0 );
+    BOOST_CHECK_EQUAL( mine, r.arena );
+    BOOST_CHECK_EQUAL( os::currentMemoryArena(), mine );
+    BOOST_CHECK( os::attachMemoryArena(16*1024) == 0 );
+
+    char* p = static_cast<char*>( oro_rt_malloc(1000) );
+    BOOST_REQUIRE( p != 0 );
+    p = static_cast<char*>( oro_rt_realloc(p, 50) );
+    p = static_cast<char*>( oro_rt_realloc(p, 4000) );
+    BOOST_REQUIRE( p != 0 );
+    BOOST_REQUIRE( os::getMemoryStats(stats, mine) );
+    BOOST_CHECK( stats.used > 4000 );
+
+    // an arena released while in use.
+    os::releaseMemoryArena();
+    BOOST_CHECK( os::currentMemoryArena() == 0 );
+    oro_rt_free(p);
+
+    BOOST_CHECK( os::getMemoryStats(stats) );
+    BOOST_CHECK( !stats.arena );
+}
+#endif
+
 BOOST_AUTO_TEST_CASE( testScheduler )
 {
     int rtsched = ORO_SCHED_OTHER;
@@ -212,6 +212,28 @@ BOOST_AUTO_TEST_CASE( testTimers )
     BOOST_CHECK( timer.occured.size() == 0 );
 }
 
+BOOST_AUTO_TEST_CASE( testTimerOrder )
+{
+    TestTimer timer;
+    // arm in the reverse order of expiry.
+    for (int i = 0; i < 32; ++i)
+        BOOST_CHECK( timer.arm(i, 0.5 - i * 0.01) );
+    // kill the even ones, which removes them from the middle of the queue.
+    for (int i = 0; i < 32; i += 2)
+        BOOST_CHECK( timer.killTimer(i) );
+    // re-arming moves an armed timer.
+    BOOST_CHECK( timer.arm(31, 0.6) );
+
+    sleep(1);
+
+    BOOST_REQUIRE_EQUAL( timer.occured.size(), 16u );
+    for (int i = 0; i < 15; ++i)
+        BOOST_CHECK_EQUAL( timer.occured[i].first, 29 - 2 * i );
+    BOOST_CHECK_EQUAL( timer.occured[15].first, 31 );
+    for (int i = 0; i < 32; ++i)
+        BOOST_CHECK( !timer.isArmed(i) );
+}
+
 BOOST_AUTO_TEST_CASE( testTimerPeriod )
 {
     TestTimer timer;
@@ -37,6 +37,15 @@ struct TypekitFixture
 {
 };
 
+struct DeferredType { int i; };
+static int deferred_loads = 0;
+
+static bool loadDeferredType()
+{
+    ++deferred_loads;
+    return Types()->addType( new types::TemplateTypeInfo<DeferredType>("DeferredType") );
+}
+
 // Registers the fixture into the 'registry'
 BOOST_FIXTURE_TEST_SUITE( TypekitTestSuite, TypekitFixture )
 
@@ -51,6 +60,25 @@ BOOST_AUTO_TEST_CASE( testVectorTypeInfo )
     Types()->addType( new types::SequenceTypeInfo<std::vector<int> >("ints") );
 }
 
+//! Tests that deferred types are installed by their first lookup.
+BOOST_AUTO_TEST_CASE( testDeferredTypes )
+{
+    std::vector<std::string> names(1, "DeferredType"), ids(1, typeid(DeferredType).name());
+    BOOST_REQUIRE( Types()->addDeferredTypes( names, ids, &loadDeferredType ) );
+    BOOST_CHECK_EQUAL( deferred_loads, 0 );
+
+    TypeInfo* ti = Types()->getTypeInfo<DeferredType>();
+    BOOST_REQUIRE( ti );
+    BOOST_CHECK_EQUAL( ti->getTypeName(), "DeferredType" );
+    BOOST_CHECK( Types()->type("DeferredType") == ti );
+    BOOST_CHECK_EQUAL( deferred_loads, 1 );
+
+    // known types are not deferred again:
+    BOOST_CHECK( !Types()->addDeferredTypes( names, ids, &loadDeferredType ) );
+    BOOST_CHECK( Types()->type("DeferredType") == ti );
+    BOOST_CHECK_EQUAL( deferred_loads, 1 );
+}
+
 //! This test tries to compose/decompose a default built variable of
 //! every known type. So this is not a test covering the nominal case...
 BOOST_AUTO_TEST_CASE( testComposeDecompose )